@@ -1,52 +1,18 @@
 #include "Admin.h"
+#include "CsvUtils.h"
+#include "AllocationTransaction.h"
+#include "AssignmentEngine.h"
+#include "BlockAllocator.h"
+#include "RoommateGrouper.h"
+#include "Validation.h"
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
 #include <fstream>
 #include <sstream>
-#include <regex>
 
 using namespace std;
 
-namespace {
-    static inline string trim(const string& s) {
-        size_t start = s.find_first_not_of(" \t\r\n");
-        if (start == string::npos) return "";
-        size_t end = s.find_last_not_of(" \t\r\n");
-        return s.substr(start, end - start + 1);
-    }
-    string csvEscape(const string& value) {
-        bool needsQuotes = value.find_first_of(",\"\n") != string::npos;
-        string out = value;
-        size_t pos = 0;
-        while ((pos = out.find('"', pos)) != string::npos) {
-            out.insert(pos, 1, '"');
-            pos += 2;
-        }
-        if (needsQuotes) return string("\"") + out + string("\"");
-        return out;
-    }
-    vector<string> csvParseLine(const string& line) {
-        vector<string> result; string cur; bool inQuotes = false;
-        for (size_t i = 0; i < line.size(); ++i) {
-            char c = line[i];
-            if (inQuotes) {
-                if (c == '"') {
-                    if (i + 1 < line.size() && line[i + 1] == '"') { cur.push_back('"'); ++i; }
-                    else { inQuotes = false; }
-                } else { cur.push_back(c); }
-            } else {
-                if (c == ',') { result.push_back(cur); cur.clear(); }
-                else if (c == '"') { inQuotes = true; }
-                else { cur.push_back(c); }
-            }
-        }
-        result.push_back(cur);
-        for (auto& t : result) t = trim(t);
-        return result;
-    }
-}
-
 // Default constructor
 Admin::Admin() : adminId(""), username(""), password(""), name(""), email("") {}
 
@@ -71,93 +37,93 @@ void Admin::changePassword(const string& newPassword) {
 }
 
 // Student Management
-void Admin::addStudent(vector<Student>& students) {
+bool Admin::addStudent(vector<Student>& students, HostelIndex& index) {
     Student newStudent;
     newStudent.inputDetails();
     // Enforce 13-digit student ID format
-    if (!regex_match(newStudent.getStudentId(), regex(R"(\d{13})"))) {
+    if (!Validation::isStudentId(newStudent.getStudentId())) {
         cout << "Error: Student ID must be exactly 13 digits (e.g., 2024010015138)." << endl;
-        return;
+        return false;
     }
     
     // Check if student ID already exists
-    for (const auto& student : students) {
-        if (student.getStudentId() == newStudent.getStudentId()) {
-            cout << "Error: Student ID already exists!" << endl;
-            return;
-        }
+    if (index.hasStudent(newStudent.getKey())) {
+        cout << "Error: Student ID already exists!" << endl;
+        return false;
     }
     
     students.push_back(newStudent);
+    index.studentAppended(students);
     cout << "Student added successfully!" << endl;
+    return true;
 }
 
-void Admin::removeStudent(vector<Student>& students, const string& studentId) {
-    auto it = find_if(students.begin(), students.end(),
-        [&studentId](const Student& s) { return s.getStudentId() == studentId; });
+bool Admin::removeStudent(vector<Student>& students, HostelIndex& index,
+                          const string& studentId) {
+    StudentKey key = Keys::findStudent(studentId);
+    size_t slot = index.studentSlot(key);
     
-    if (it != students.end()) {
-        if (it->getIsAllocated()) {
+    if (slot != HostelIndex::npos) {
+        if (students[slot].getIsAllocated()) {
             cout << "Warning: Student is currently allocated to a room. Deallocate first." << endl;
-            return;
+            return false;
         }
-        students.erase(it);
+        students.erase(students.begin() + slot);
+        index.studentErased(students, slot, key);
         cout << "Student removed successfully!" << endl;
+        return true;
     } else {
         cout << "Student not found!" << endl;
+        return false;
     }
 }
 
-void Admin::updateStudent(vector<Student>& students, const string& studentId) {
-    Student* student = findStudent(students, studentId);
+bool Admin::updateStudent(vector<Student>& students, HostelIndex& index,
+                          const string& studentId) {
+    Student* student = findStudent(students, index, Keys::findStudent(studentId));
     if (student) {
         cout << "Current student information:" << endl;
-        student->displayInfo();
+        student->displayInfo(cout);
         cout << "\nEnter new details:" << endl;
         // Capture original ID to allow same-ID updates
-        string originalId = student->getStudentId();
+        StudentKey originalId = student->getKey();
         Student temp = *student;
         temp.inputDetails();
         // Enforce unique ID (except if unchanged)
-        const string& newId = temp.getStudentId();
+        StudentKey newId = temp.getKey();
         // Enforce 13-digit format
-        if (!regex_match(newId, regex(R"(\d{13})"))) {
+        if (!Validation::isStudentId(temp.getStudentId())) {
             cout << "Error: Student ID must be exactly 13 digits (e.g., 2024010015138). Update cancelled." << endl;
-            return;
+            return false;
         }
-        if (newId != originalId) {
-            bool exists = any_of(students.begin(), students.end(), [&](const Student& s){
-                return s.getStudentId() == newId;
-            });
-            if (exists) {
-                cout << "Error: Student ID already exists! Update cancelled." << endl;
-                return;
-            }
+        if (newId != originalId && index.hasStudent(newId)) {
+            cout << "Error: Student ID already exists! Update cancelled." << endl;
+            return false;
         }
         *student = temp;
+        index.studentRekeyed(originalId, newId);
+        index.studentChanged(students, index.studentSlot(newId));
         cout << "Student updated successfully!" << endl;
+        return true;
     } else {
         cout << "Student not found!" << endl;
+        return false;
     }
 }
 
-void Admin::displayAllStudents(const vector<Student>& students) const {
-    if (students.empty()) {
-        cout << "No students found." << endl;
-        return;
+namespace {
+    void printStudentHeader(ostream& out) {
+        out << left << setw(12) << "Student ID" 
+                  << setw(20) << "Name" 
+                  << setw(15) << "Course" 
+                  << setw(8) << "Year" 
+                  << setw(15) << "Status" 
+                  << setw(15) << "Room" << endl;
+        out << string(85, '-') << endl;
     }
-    
-    cout << "\n=== All Students ===" << endl;
-    cout << left << setw(12) << "Student ID" 
-              << setw(20) << "Name" 
-              << setw(15) << "Course" 
-              << setw(8) << "Year" 
-              << setw(15) << "Status" 
-              << setw(15) << "Room" << endl;
-    cout << string(85, '-') << endl;
-    
-    for (const auto& student : students) {
-        cout << left << setw(12) << student.getStudentId()
+
+    void printStudentRow(const Student& student, ostream& out) {
+        out << left << setw(12) << student.getStudentId()
                   << setw(20) << student.getName()
                   << setw(15) << student.getCourse()
                   << setw(8) << student.getYear()
@@ -167,77 +133,109 @@ void Admin::displayAllStudents(const vector<Student>& students) const {
     }
 }
 
-Student* Admin::findStudent(vector<Student>& students, const string& studentId) {
-    auto it = find_if(students.begin(), students.end(),
-        [&studentId](const Student& s) { return s.getStudentId() == studentId; });
+void Admin::displayAllStudents(const vector<Student>& students) const {
+    if (students.empty()) {
+        cout << "No students found." << endl;
+        return;
+    }
     
-    return (it != students.end()) ? &(*it) : nullptr;
+    cout << "\n=== All Students ===" << endl;
+    printStudentHeader(cout);
+    for (const auto& student : students) printStudentRow(student, cout);
+}
+
+void Admin::displayStudents(const vector<Student>& students, const vector<size_t>& slots, ostream& out) {
+    printStudentHeader(out);
+    for (size_t slot : slots) {
+        if (slot < students.size()) printStudentRow(students[slot], out);
+    }
+}
+
+Student* Admin::findStudent(vector<Student>& students, const HostelIndex& index,
+                            StudentKey studentId) {
+    return index.findStudent(students, studentId);
 }
 
 // Room Management
-void Admin::addRoom(vector<Room>& rooms) {
+bool Admin::addRoom(vector<Room>& rooms, HostelIndex& index) {
     Room newRoom;
     newRoom.inputDetails();
     
     // Check if room number already exists
-    for (const auto& room : rooms) {
-        if (room.getRoomNumber() == newRoom.getRoomNumber()) {
-            cout << "Error: Room number already exists!" << endl;
-            return;
-        }
+    if (index.hasRoom(newRoom.getKey())) {
+        cout << "Error: Room number already exists!" << endl;
+        return false;
     }
     
     rooms.push_back(newRoom);
+    index.roomAppended(rooms);
     cout << "Room added successfully!" << endl;
+    return true;
 }
 
-void Admin::removeRoom(vector<Room>& rooms, const string& roomNumber) {
-    auto it = find_if(rooms.begin(), rooms.end(),
-        [&roomNumber](const Room& r) { return r.getRoomNumber() == roomNumber; });
+bool Admin::removeRoom(vector<Room>& rooms, HostelIndex& index, const string& roomNumber) {
+    RoomKey key = Keys::findRoom(roomNumber);
+    size_t slot = index.roomSlot(key);
     
-    if (it != rooms.end()) {
-        if (!it->isEmpty()) {
+    if (slot != HostelIndex::npos) {
+        if (!rooms[slot].isEmpty()) {
             cout << "Warning: Room is not empty. Remove occupants first." << endl;
-            return;
+            return false;
         }
-        rooms.erase(it);
+        rooms.erase(rooms.begin() + slot);
+        index.roomErased(rooms, slot, key);
         cout << "Room removed successfully!" << endl;
+        return true;
     } else {
         cout << "Room not found!" << endl;
+        return false;
     }
 }
 
-void Admin::updateRoom(vector<Room>& rooms, const string& roomNumber) {
-    Room* room = findRoom(rooms, roomNumber);
+bool Admin::updateRoom(vector<Room>& rooms, HostelIndex& index, const string& roomNumber) {
+    RoomKey key = Keys::findRoom(roomNumber);
+    Room* room = findRoom(rooms, index, key);
     if (room) {
         cout << "Current room information:" << endl;
-        room->displayInfo();
+        room->displayInfo(cout);
         cout << "\nEnter new details:" << endl;
-        room->inputDetails();
+        Room temp = *room;
+        temp.inputDetails();
+        // Room numbers are index keys; keep them unique
+        RoomKey newNumber = temp.getKey();
+        if (newNumber != key && index.hasRoom(newNumber)) {
+            cout << "Error: Room number already exists! Update cancelled." << endl;
+            return false;
+        }
+        if (temp.getCapacity() < temp.getCurrentOccupancy()) {
+            cout << "Error: Capacity is below the current occupancy! Update cancelled." << endl;
+            return false;
+        }
+        *room = temp;
+        index.roomRekeyed(key, newNumber);
+        index.roomChanged(rooms, index.roomSlot(newNumber));
         cout << "Room updated successfully!" << endl;
+        return true;
     } else {
         cout << "Room not found!" << endl;
+        return false;
     }
 }
 
-void Admin::displayAllRooms(const vector<Room>& rooms) const {
-    if (rooms.empty()) {
-        cout << "No rooms found." << endl;
-        return;
+namespace {
+    void printRoomHeader(ostream& out) {
+        out << left << setw(12) << "Room No" 
+                  << setw(12) << "Type" 
+                  << setw(10) << "Capacity" 
+                  << setw(10) << "Occupied" 
+                  << setw(10) << "Available" 
+                  << setw(10) << "Rent" 
+                  << setw(10) << "Status" << endl;
+        out << string(74, '-') << endl;
     }
-    
-    cout << "\n=== All Rooms ===" << endl;
-    cout << left << setw(12) << "Room No" 
-              << setw(12) << "Type" 
-              << setw(10) << "Capacity" 
-              << setw(10) << "Occupied" 
-              << setw(10) << "Available" 
-              << setw(10) << "Rent" 
-              << setw(10) << "Status" << endl;
-    cout << string(74, '-') << endl;
-    
-    for (const auto& room : rooms) {
-        cout << left << setw(12) << room.getRoomNumber()
+
+    void printRoomRow(const Room& room, ostream& out) {
+        out << left << setw(12) << room.getRoomNumber()
                   << setw(12) << room.getRoomType()
                   << setw(10) << room.getCapacity()
                   << setw(10) << room.getCurrentOccupancy()
@@ -248,213 +246,335 @@ void Admin::displayAllRooms(const vector<Room>& rooms) const {
     }
 }
 
-Room* Admin::findRoom(vector<Room>& rooms, const string& roomNumber) {
-    auto it = find_if(rooms.begin(), rooms.end(),
-        [&roomNumber](const Room& r) { return r.getRoomNumber() == roomNumber; });
+void Admin::displayAllRooms(const vector<Room>& rooms) const {
+    if (rooms.empty()) {
+        cout << "No rooms found." << endl;
+        return;
+    }
     
-    return (it != rooms.end()) ? &(*it) : nullptr;
+    cout << "\n=== All Rooms ===" << endl;
+    printRoomHeader(cout);
+    for (const auto& room : rooms) printRoomRow(room, cout);
+}
+
+void Admin::displayRooms(const vector<Room>& rooms, const vector<size_t>& slots, ostream& out) {
+    printRoomHeader(out);
+    for (size_t slot : slots) {
+        if (slot < rooms.size()) printRoomRow(rooms[slot], out);
+    }
+}
+
+Room* Admin::findRoom(vector<Room>& rooms, const HostelIndex& index, RoomKey roomNumber) {
+    return index.findRoom(rooms, roomNumber);
 }
 
 // Room Allocation
-bool Admin::allocateRoom(vector<Student>& students, vector<Room>& rooms, 
-                         const string& studentId, const string& roomNumber) {
-    Student* student = findStudent(students, studentId);
-    Room* room = findRoom(rooms, roomNumber);
+bool Admin::allocateRoom(vector<Student>& students, vector<Room>& rooms, HostelIndex& index,
+                         StudentKey studentId, RoomKey roomNumber, ostream& out) {
+    Student* student = findStudent(students, index, studentId);
+    Room* room = findRoom(rooms, index, roomNumber);
     
     if (!student) {
-        cout << "Student not found!" << endl;
+        out << "Student not found!" << endl;
         return false;
     }
     
     if (!room) {
-        cout << "Room not found!" << endl;
+        out << "Room not found!" << endl;
         return false;
     }
     
     if (student->getIsAllocated()) {
-        cout << "Student is already allocated to a room!" << endl;
+        out << "Student is already allocated to a room!" << endl;
         return false;
     }
     
-    if (room->isFull()) {
-        cout << "Room is full!" << endl;
+    // Claim the bed first; the reservation, not a separate isFull() check,
+    // is what keeps concurrent allocators from overfilling the room
+    if (!index.reserveBed(index.roomSlot(roomNumber))) {
+        out << "Room is full!" << endl;
+        return false;
+    }
+    return commitAllocation(students, rooms, index, studentId, roomNumber, out);
+}
+
+bool Admin::commitAllocation(vector<Student>& students, vector<Room>& rooms, HostelIndex& index,
+                             StudentKey studentId, RoomKey roomNumber, ostream& out) {
+    size_t roomSlot = index.roomSlot(roomNumber);
+    Student* student = findStudent(students, index, studentId);
+    if (!student || student->getIsAllocated()) {
+        out << (student ? "Student is already allocated to a room!" : "Student not found!") << endl;
+        index.cancelReservation(roomSlot);
         return false;
     }
     
-    // Allocate room
-    if (room->addOccupant(studentId)) {
-        student->setAllocatedRoom(roomNumber);
-        cout << "Room allocated successfully!" << endl;
+    // Allocate room (through the index so its availability buckets follow)
+    if (index.commitOccupant(rooms, roomSlot, studentId)) {
+        student->setRoomKey(roomNumber);
+        index.studentChanged(students, index.studentSlot(studentId));
+        out << "Room allocated successfully!" << endl;
         return true;
     }
     
+    index.cancelReservation(roomSlot);
     return false;
 }
 
-bool Admin::deallocateRoom(vector<Student>& students, vector<Room>& rooms, 
-                           const string& studentId) {
-    Student* student = findStudent(students, studentId);
+bool Admin::deallocateRoom(vector<Student>& students, vector<Room>& rooms, HostelIndex& index,
+                           StudentKey studentId, ostream& out) {
+    Student* student = findStudent(students, index, studentId);
     
     if (!student) {
-        cout << "Student not found!" << endl;
+        out << "Student not found!" << endl;
         return false;
     }
     
     if (!student->getIsAllocated()) {
-        cout << "Student is not allocated to any room!" << endl;
+        out << "Student is not allocated to any room!" << endl;
         return false;
     }
     
-    Room* room = findRoom(rooms, student->getAllocatedRoom());
-    if (room) {
-        room->removeOccupant(studentId);
+    size_t roomSlot = index.roomSlot(student->getRoomKey());
+    if (roomSlot != HostelIndex::npos) {
+        index.removeOccupant(rooms, roomSlot, studentId);
     }
     
-    student->setAllocatedRoom("");
-    cout << "Room deallocated successfully!" << endl;
+    student->setRoomKey(Keys::NONE);
+    index.studentChanged(students, index.studentSlot(studentId));
+    out << "Room deallocated successfully!" << endl;
     return true;
 }
 
-void Admin::autoAllocateRooms(vector<Student>& students, vector<Room>& rooms) {
+void Admin::autoAllocateRooms(vector<Student>& students, vector<Room>& rooms, HostelIndex& index) {
     cout << "Starting automatic room allocation..." << endl;
     
-    // Sort students by year (seniors first)
-    sort(students.begin(), students.end(),
-        [](const Student& a, const Student& b) { return a.getYear() > b.getYear(); });
+    // Order student slots by year (seniors first); the vector itself is left
+    // in place so the index slots stay valid
+    vector<size_t> order(students.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    stable_sort(order.begin(), order.end(),
+        [&students](size_t a, size_t b) { return students[a].getYear() > students[b].getYear(); });
     
     int allocated = 0;
-    for (auto& student : students) {
+    for (size_t slot : order) {
+        Student& student = students[slot];
         if (student.getIsAllocated()) continue;
         
-        // Find available room
-        for (auto& room : rooms) {
-            if (room.getIsAvailable()) {
-                if (allocateRoom(students, rooms, student.getStudentId(), room.getRoomNumber())) {
-                    allocated++;
-                    break;
-                }
-            }
+        // Take a room with a free slot from the availability buckets
+        size_t roomSlot = index.findRoomWithSlots(1);
+        if (roomSlot == HostelIndex::npos) break; // every room is full
+        if (allocateRoom(students, rooms, index, student.getKey(), rooms[roomSlot].getKey(), cout)) {
+            allocated++;
         }
     }
     
     cout << "Automatic allocation completed. " << allocated << " students allocated." << endl;
 }
 
-void Admin::allocateWithRoommatePreference(vector<Student>& students, vector<Room>& rooms) {
-    cout << "Starting roommate preference allocation..." << endl;
+void Admin::allocateOptimal(vector<Student>& students, vector<Room>& rooms, HostelIndex& index) {
+    cout << "Starting optimal preference-aware allocation..." << endl;
     
-    int allocated = 0;
-    for (auto& student : students) {
-        if (student.getIsAllocated()) continue;
-        
-        // Check if student has roommate preference
-        if (!student.getPreferredRoommate().empty()) {
-            Student* preferredRoommate = findStudent(students, student.getPreferredRoommate());
-            
-            if (preferredRoommate && !preferredRoommate->getIsAllocated()) {
-                // Find room that can accommodate both
-                for (auto& room : rooms) {
-                    if (room.getCapacity() >= 2 && room.getAvailableSlots() >= 2) {
-                        // Allocate both students
-                        if (allocateRoom(students, rooms, student.getStudentId(), room.getRoomNumber()) &&
-                            allocateRoom(students, rooms, preferredRoommate->getStudentId(), room.getRoomNumber())) {
-                            allocated += 2;
-                            cout << "Allocated " << student.getName() << " and " 
-                                      << preferredRoommate->getName() << " to room " 
-                                      << room.getRoomNumber() << endl;
-                            break;
-                        }
-                    }
-                }
-            }
+    // Plan every bed at once, then apply it with the usual allocation checks
+    AssignmentEngine::Plan plan = AssignmentEngine::solve(students, index);
+    int allocated = 0, firstChoice = 0, otherChoice = 0, noChoice = 0;
+    for (const auto& assignment : plan.assignments) {
+        if (!allocateRoom(students, rooms, index, students[assignment.studentSlot].getKey(),
+                          rooms[assignment.roomSlot].getKey(), cout)) {
+            continue;
         }
+        allocated++;
+        if (assignment.rank == 0) firstChoice++;
+        else if (assignment.rank > 0) otherChoice++;
+        else noChoice++;
     }
     
-    // Allocate remaining students
-    autoAllocateRooms(students, rooms);
-    cout << "Roommate preference allocation completed." << endl;
+    cout << "Optimal allocation completed. " << allocated << " students allocated." << endl;
+    cout << "  First choice: " << firstChoice << ", other preference: " << otherChoice
+         << ", no preference met: " << noChoice << endl;
+    if (plan.unassigned > 0) {
+        cout << "  " << plan.unassigned << " students left unallocated (no free beds)." << endl;
+    }
 }
 
-// Reports and Statistics
-void Admin::generateAllocationReport(const vector<Student>& students, 
-                                     const vector<Room>& rooms) const {
-    cout << "\n=== ALLOCATION REPORT ===" << endl;
+void Admin::allocateByBlock(vector<Student>& students, vector<Room>& rooms, HostelIndex& index,
+                            uint32_t seed) {
+    cout << "Starting block-partitioned allocation (seed " << seed << ")..." << endl;
+    
+    // Blocks are planned in parallel, then applied here in seniority order
+    BlockAllocator::Plan plan = BlockAllocator::plan(students, index, seed, 0);
+    int allocated = 0, preferred = 0;
+    for (const auto& assignment : plan.assignments) {
+        if (!allocateRoom(students, rooms, index, students[assignment.studentSlot].getKey(),
+                          rooms[assignment.roomSlot].getKey(), cout)) {
+            continue;
+        }
+        allocated++;
+        if (assignment.rank >= 0) preferred++;
+    }
     
-    int totalStudents = students.size();
-    int allocatedStudents = 0;
-    int totalRooms = rooms.size();
-    int occupiedRooms = 0;
-    int totalCapacity = 0;
-    int totalOccupancy = 0;
+    cout << "Block allocation completed. " << allocated << " students allocated across "
+         << plan.blocks << " blocks." << endl;
+    cout << "  In home block: " << plan.placedInBlock << ", overflow to other blocks: "
+         << plan.placedByOverflow << ", preferred room: " << preferred << endl;
+    if (plan.unassigned > 0) {
+        cout << "  " << plan.unassigned << " students left unallocated (no free beds)." << endl;
+    }
+}
+
+void Admin::allocateWithRoommatePreference(vector<Student>& students, vector<Room>& rooms,
+                                           HostelIndex& index) {
+    cout << "Starting roommate preference allocation..." << endl;
     
-    for (const auto& student : students) {
-        if (student.getIsAllocated()) allocatedStudents++;
+    // Groups can be no larger than the roomiest free room
+    size_t maxGroup = 0;
+    for (size_t n = RoommateGrouper::MAX_GROUP; n >= 2 && maxGroup == 0; --n) {
+        if (index.findRoomWithSlots(static_cast<int>(n)) != HostelIndex::npos) maxGroup = n;
     }
     
-    for (const auto& room : rooms) {
-        totalCapacity += room.getCapacity();
-        totalOccupancy += room.getCurrentOccupancy();
-        if (!room.isEmpty()) occupiedRooms++;
+    // Largest groups first, each into the fullest room that still holds it;
+    // a group moves in as one transaction, so it is never left split
+    auto placeTogether = [&](const vector<size_t>& members) {
+        size_t roomSlot = index.findRoomWithSlots(static_cast<int>(members.size()));
+        if (roomSlot == HostelIndex::npos) return 0;
+        AllocationTransaction group(students, rooms, index);
+        string names;
+        for (size_t k = 0; k < members.size(); ++k) {
+            group.stageAllocate(students[members[k]].getKey(), rooms[roomSlot].getKey());
+            if (k > 0) names += (k + 1 == members.size()) ? " and " : ", ";
+            names += students[members[k]].getName();
+        }
+        if (!group.commit()) return 0;
+        cout << "Allocated " << names << " to room " << rooms[roomSlot].getRoomNumber() << endl;
+        return static_cast<int>(members.size());
+    };
+    int allocated = 0;
+    for (const auto& group : RoommateGrouper::group(students, index, maxGroup)) {
+        int placed = placeTogether(group);
+        // No room for the whole group: keep the students who named each
+        // other paired, and leave the rest to the general allocation
+        if (placed == 0) {
+            for (const auto& pair : RoommateGrouper::pairs(students, index, group)) {
+                allocated += placeTogether(pair);
+            }
+        }
+        allocated += placed;
     }
     
-    cout << "Total Students: " << totalStudents << endl;
-    cout << "Allocated Students: " << allocatedStudents << endl;
-    cout << "Unallocated Students: " << (totalStudents - allocatedStudents) << endl;
-    cout << "Total Rooms: " << totalRooms << endl;
-    cout << "Occupied Rooms: " << occupiedRooms << endl;
-    cout << "Empty Rooms: " << (totalRooms - occupiedRooms) << endl;
-    cout << "Total Capacity: " << totalCapacity << endl;
-    cout << "Total Occupancy: " << totalOccupancy << endl;
-    cout << "Occupancy Rate: " << fixed << setprecision(2) 
-              << (totalCapacity > 0 ? (double)totalOccupancy / totalCapacity * 100 : 0) << "%" << endl;
-}
-
-void Admin::generateOccupancyReport(const vector<Room>& rooms) const {
-    cout << "\n=== OCCUPANCY REPORT ===" << endl;
+    // Join a roommate who already has a room, if it has a bed left
+    for (auto& student : students) {
+        if (student.getIsAllocated() || student.getRoommateKey() == Keys::NONE) continue;
+        Student* preferredRoommate = findStudent(students, index, student.getRoommateKey());
+        if (!preferredRoommate || !preferredRoommate->getIsAllocated()) continue;
+        Room* room = findRoom(rooms, index, preferredRoommate->getRoomKey());
+        if (room && !room->isFull() &&
+            allocateRoom(students, rooms, index, student.getKey(), room->getKey(), cout)) {
+            allocated++;
+        }
+    }
     
-    map<string, int> typeCount;
-    map<string, int> typeOccupancy;
+    // Allocate remaining students
+    autoAllocateRooms(students, rooms, index);
     
-    for (const auto& room : rooms) {
-        typeCount[room.getRoomType()]++;
-        typeOccupancy[room.getRoomType()] += room.getCurrentOccupancy();
+    int wanted = 0, met = 0;
+    for (const auto& student : students) {
+        if (student.getRoommateKey() == Keys::NONE || student.getRoommateKey() == student.getKey()) continue;
+        size_t roommateSlot = index.studentSlot(student.getRoommateKey());
+        if (roommateSlot == HostelIndex::npos) continue;
+        wanted++;
+        if (student.getIsAllocated() && students[roommateSlot].getIsAllocated() &&
+            student.getRoomKey() == students[roommateSlot].getRoomKey()) {
+            met++;
+        }
     }
+    cout << "Roommate preference allocation completed." << endl;
+    cout << "  " << allocated << " students placed with roommates; preferences met for " << met
+         << " of " << wanted << " students." << endl;
+}
+
+// Reports and Statistics
+void Admin::generateAllocationReport(const ReportSummary& summary, ostream& out) const {
+    out << "\n=== ALLOCATION REPORT ===" << endl;
+    
+    out << "Total Students: " << summary.totalStudents << endl;
+    out << "Allocated Students: " << summary.allocatedStudents << endl;
+    out << "Unallocated Students: " << (summary.totalStudents - summary.allocatedStudents) << endl;
+    out << "Total Rooms: " << summary.totalRooms << endl;
+    out << "Occupied Rooms: " << summary.occupiedRooms << endl;
+    out << "Empty Rooms: " << (summary.totalRooms - summary.occupiedRooms) << endl;
+    out << "Total Capacity: " << summary.totalCapacity << endl;
+    out << "Total Occupancy: " << summary.totalOccupancy << endl;
+    out << "Occupancy Rate: " << fixed << setprecision(2) 
+              << (summary.totalCapacity > 0 ? (double)summary.totalOccupancy / summary.totalCapacity * 100 : 0)
+              << "%" << endl;
+}
+
+void Admin::generateOccupancyReport(const ReportSummary& summary, ostream& out) const {
+    out << "\n=== OCCUPANCY REPORT ===" << endl;
     
-    cout << left << setw(12) << "Room Type" 
+    out << left << setw(12) << "Room Type" 
               << setw(10) << "Count" 
               << setw(12) << "Occupancy" << endl;
-    cout << string(34, '-') << endl;
+    out << string(34, '-') << endl;
     
-    for (const auto& pair : typeCount) {
-        cout << left << setw(12) << pair.first
-                  << setw(10) << pair.second
-                  << setw(12) << typeOccupancy[pair.first] << endl;
+    for (const auto& group : summary.byType) {
+        out << left << setw(12) << group.first
+                  << setw(10) << group.second.rooms
+                  << setw(12) << group.second.occupancy << endl;
     }
 }
 
-void Admin::generateStudentReport(const vector<Student>& students) const {
-    cout << "\n=== STUDENT REPORT ===" << endl;
+void Admin::generateStudentReport(const ReportSummary& summary, ostream& out) const {
+    out << "\n=== STUDENT REPORT ===" << endl;
     
-    map<string, int> courseCount;
-    map<int, int> yearCount;
-    
-    for (const auto& student : students) {
-        courseCount[student.getCourse()]++;
-        yearCount[student.getYear()]++;
+    out << "By Course:" << endl;
+    out << left << setw(20) << "Course" << setw(10) << "Count" << endl;
+    out << string(30, '-') << endl;
+    for (const auto& pair : summary.byCourse) {
+        out << left << setw(20) << pair.first << setw(10) << pair.second << endl;
     }
     
-    cout << "By Course:" << endl;
-    cout << left << setw(20) << "Course" << setw(10) << "Count" << endl;
-    cout << string(30, '-') << endl;
-    for (const auto& pair : courseCount) {
-        cout << left << setw(20) << pair.first << setw(10) << pair.second << endl;
+    out << "\nBy Year:" << endl;
+    out << left << setw(10) << "Year" << setw(10) << "Count" << endl;
+    out << string(20, '-') << endl;
+    for (const auto& pair : summary.byYear) {
+        out << left << setw(10) << pair.first << setw(10) << pair.second << endl;
     }
-    
-    cout << "\nBy Year:" << endl;
-    cout << left << setw(10) << "Year" << setw(10) << "Count" << endl;
-    cout << string(20, '-') << endl;
-    for (const auto& pair : yearCount) {
-        cout << left << setw(10) << pair.first << setw(10) << pair.second << endl;
+}
+
+void Admin::generateBreakdownReport(const ReportSummary& summary, ostream& out) const {
+    out << "\n=== BLOCK / FLOOR / RENT BREAKDOWN ===" << endl;
+    
+    auto printGroup = [&out](const string& label, const string& name, const ReportSummary::Tally& tally) {
+        out << left << setw(16) << (label + " " + name)
+                  << setw(10) << tally.rooms
+                  << setw(10) << tally.capacity
+                  << setw(12) << tally.occupancy
+                  << fixed << setprecision(2)
+                  << (tally.capacity > 0 ? (double)tally.occupancy / tally.capacity * 100 : 0) << "%" << endl;
+    };
+    auto printHeader = [&out](const string& title) {
+        out << "\n" << title << ":" << endl;
+        out << left << setw(16) << "Group" 
+                  << setw(10) << "Rooms" 
+                  << setw(10) << "Capacity" 
+                  << setw(12) << "Occupancy" 
+                  << "Rate" << endl;
+        out << string(56, '-') << endl;
+    };
+    
+    printHeader("By Block");
+    for (const auto& group : summary.byBlock) printGroup("Block", group.first, group.second);
+    
+    printHeader("By Floor");
+    for (const auto& group : summary.byFloor) printGroup("Floor", group.first, group.second);
+    
+    printHeader("By Rent");
+    const int openBand = (ReportEngine::MAX_RENT_BANDS - 1) * ReportEngine::RENT_STEP;
+    for (const auto& group : summary.byRent) {
+        string range = (group.first >= openBand)
+            ? to_string(group.first) + "+"
+            : to_string(group.first) + "-" + to_string(group.first + ReportEngine::RENT_STEP - 1);
+        printGroup("$", range, group.second);
     }
 }
 
@@ -504,14 +624,19 @@ void Admin::saveToFile(ostream& file) const {
 
 bool Admin::loadFromFile(istream& is) {
     string line;
-    if (!getline(is, line)) return false;
+    if (!csvReadRecord(is, line)) return false;
     vector<string> tokens = csvParseLine(line);
-    if (tokens.size() < 5) return false;
-    adminId = tokens[0];
-    username = tokens[1];
-    password = tokens[2];
-    name = tokens[3];
-    email = tokens[4];
+    vector<string_view> fields(tokens.begin(), tokens.end());
+    return loadFromFields(fields);
+}
+
+bool Admin::loadFromFields(const vector<string_view>& fields) {
+    if (fields.size() < 5) return false;
+    adminId.assign(fields[0]);
+    username.assign(fields[1]);
+    password.assign(fields[2]);
+    name.assign(fields[3]);
+    email.assign(fields[4]);
     return true;
 }
 
@@ -23,8 +23,11 @@
 
 #include "Student.h"
 #include "Room.h"
+#include "HostelIndex.h"
+#include "ReportEngine.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
 
 using namespace std;
@@ -54,32 +57,46 @@ public:
     void changePassword(const string& newPassword);
     
     // Student Management
-    void addStudent(vector<Student>& students);
-    void removeStudent(vector<Student>& students, const string& studentId);
-    void updateStudent(vector<Student>& students, const string& studentId);
+    bool addStudent(vector<Student>& students, HostelIndex& index);
+    bool removeStudent(vector<Student>& students, HostelIndex& index, const string& studentId);
+    bool updateStudent(vector<Student>& students, HostelIndex& index, const string& studentId);
     void displayAllStudents(const vector<Student>& students) const;
-    Student* findStudent(vector<Student>& students, const string& studentId);
+    // Table of the given student slots (search results); needs no login
+    static void displayStudents(const vector<Student>& students, const vector<size_t>& slots,
+                                ostream& out);
+    Student* findStudent(vector<Student>& students, const HostelIndex& index,
+                         StudentKey studentId);
     
     // Room Management
-    void addRoom(vector<Room>& rooms);
-    void removeRoom(vector<Room>& rooms, const string& roomNumber);
-    void updateRoom(vector<Room>& rooms, const string& roomNumber);
+    bool addRoom(vector<Room>& rooms, HostelIndex& index);
+    bool removeRoom(vector<Room>& rooms, HostelIndex& index, const string& roomNumber);
+    bool updateRoom(vector<Room>& rooms, HostelIndex& index, const string& roomNumber);
     void displayAllRooms(const vector<Room>& rooms) const;
-    Room* findRoom(vector<Room>& rooms, const string& roomNumber);
+    // Table of the given room slots; needs no login
+    static void displayRooms(const vector<Room>& rooms, const vector<size_t>& slots, ostream& out);
+    Room* findRoom(vector<Room>& rooms, const HostelIndex& index, RoomKey roomNumber);
     
     // Room Allocation
-    bool allocateRoom(vector<Student>& students, vector<Room>& rooms, 
-                      const string& studentId, const string& roomNumber);
-    bool deallocateRoom(vector<Student>& students, vector<Room>& rooms, 
-                        const string& studentId);
-    void autoAllocateRooms(vector<Student>& students, vector<Room>& rooms);
-    void allocateWithRoommatePreference(vector<Student>& students, vector<Room>& rooms);
+    bool allocateRoom(vector<Student>& students, vector<Room>& rooms, HostelIndex& index,
+                      StudentKey studentId, RoomKey roomNumber, ostream& out);
+    // Second half of allocateRoom for a bed the caller already reserved with
+    // HostelIndex::reserveBed; the reservation is cancelled on failure
+    bool commitAllocation(vector<Student>& students, vector<Room>& rooms, HostelIndex& index,
+                          StudentKey studentId, RoomKey roomNumber, ostream& out);
+    bool deallocateRoom(vector<Student>& students, vector<Room>& rooms, HostelIndex& index,
+                        StudentKey studentId, ostream& out);
+    void autoAllocateRooms(vector<Student>& students, vector<Room>& rooms, HostelIndex& index);
+    void allocateOptimal(vector<Student>& students, vector<Room>& rooms, HostelIndex& index);
+    void allocateByBlock(vector<Student>& students, vector<Room>& rooms, HostelIndex& index,
+                         uint32_t seed);
+    void allocateWithRoommatePreference(vector<Student>& students, vector<Room>& rooms,
+                                        HostelIndex& index);
     
-    // Reports and Statistics
-    void generateAllocationReport(const vector<Student>& students, 
-                                  const vector<Room>& rooms) const;
-    void generateOccupancyReport(const vector<Room>& rooms) const;
-    void generateStudentReport(const vector<Student>& students) const;
+    // Reports and Statistics (figures come from ReportEngine::compute)
+    void generateAllocationReport(const ReportSummary& summary, ostream& out) const;
+    void generateOccupancyReport(const ReportSummary& summary, ostream& out) const;
+    void generateStudentReport(const ReportSummary& summary, ostream& out) const;
+    void generateBreakdownReport(const ReportSummary& summary, ostream& out) const;
     
     // Utility functions
     void displayMenu() const;
@@ -89,6 +106,10 @@ public:
     // File operations
     void saveToFile(ostream& os) const;
     bool loadFromFile(istream& is);
+    bool loadFromFields(const vector<string_view>& fields);
+    
+    // Binary snapshots read and write the fields directly
+    friend class Snapshot;
     
     // Friend functions for file operations
     friend ostream& operator<<(ostream& os, const Admin& admin);
@@ -0,0 +1,142 @@
+#include "AllocationTransaction.h"
+#include <iostream>
+#include <unordered_map>
+
+using namespace std;
+
+AllocationTransaction::AllocationTransaction(vector<Student>& students, vector<Room>& rooms,
+                                             HostelIndex& index)
+    : students(students), rooms(rooms), index(index) {}
+
+// Staging
+void AllocationTransaction::stageAllocate(StudentKey studentId, RoomKey roomNumber) {
+    staged.push_back({studentId, roomNumber});
+}
+
+void AllocationTransaction::stageDeallocate(StudentKey studentId) {
+    staged.push_back({studentId, Keys::NONE});
+}
+
+size_t AllocationTransaction::size() const {
+    return staged.size();
+}
+
+// Commit
+bool AllocationTransaction::validate(vector<Step>& releases, vector<Step>& placements) const {
+    struct Seen {
+        bool released = false;
+        bool placed = false;
+    };
+    unordered_map<StudentKey, Seen> seen;
+    unordered_map<size_t, int> bedsGained; // room slot -> arrivals minus departures
+    auto fail = [](const string& reason) {
+        cout << "Transaction aborted: " << reason << endl;
+        return false;
+    };
+
+    for (const Step& step : staged) {
+        size_t studentSlot = index.studentSlot(step.studentId);
+        if (studentSlot == HostelIndex::npos) {
+            return fail("student " + Keys::studentId(step.studentId) + " not found");
+        }
+        const Student& student = students[studentSlot];
+        Seen& steps = seen[step.studentId];
+        if (step.roomNumber == Keys::NONE) {
+            if (steps.released || steps.placed) {
+                return fail("student " + student.getStudentId() + " is deallocated twice or after an allocation");
+            }
+            if (!student.getIsAllocated()) {
+                return fail("student " + student.getStudentId() + " is not allocated to any room");
+            }
+            steps.released = true;
+            size_t roomSlot = index.roomSlot(student.getRoomKey());
+            if (roomSlot != HostelIndex::npos) bedsGained[roomSlot]--;
+            releases.push_back(step);
+        } else {
+            if (steps.placed) return fail("student " + student.getStudentId() + " is allocated twice");
+            if (student.getIsAllocated() && !steps.released) {
+                return fail("student " + student.getStudentId() + " is already allocated to a room");
+            }
+            size_t roomSlot = index.roomSlot(step.roomNumber);
+            if (roomSlot == HostelIndex::npos) {
+                return fail("room " + Keys::roomNumber(step.roomNumber) + " not found");
+            }
+            steps.placed = true;
+            bedsGained[roomSlot]++;
+            placements.push_back(step);
+        }
+    }
+
+    // Claimed beds cover occupants and reservations still in flight
+    for (const Step& step : placements) {
+        size_t roomSlot = index.roomSlot(step.roomNumber);
+        int needed = index.claimedBeds(roomSlot) + bedsGained[roomSlot];
+        if (needed > rooms[roomSlot].getCapacity()) {
+            return fail("room " + rooms[roomSlot].getRoomNumber() + " would need " + to_string(needed) +
+                        " beds but has " + to_string(rooms[roomSlot].getCapacity()));
+        }
+    }
+    return true;
+}
+
+bool AllocationTransaction::commit() {
+    vector<Step> releases, placements;
+    committed.clear();
+    bool valid = validate(releases, placements);
+    staged.clear();
+    if (!valid) return false;
+
+    // Departures first, so the arrivals find their beds free
+    vector<Step> undo; // each release with the room it left
+    for (const Step& step : releases) {
+        undo.push_back({step.studentId, students[index.studentSlot(step.studentId)].getRoomKey()});
+        release(step.studentId);
+    }
+    size_t placed = 0;
+    while (placed < placements.size() && place(placements[placed])) placed++;
+
+    if (placed < placements.size()) {
+        // Validation should make this unreachable; put everything back
+        cout << "Transaction aborted: room " << Keys::roomNumber(placements[placed].roomNumber)
+             << " could not take its occupant; nothing was changed." << endl;
+        while (placed-- > 0) release(placements[placed].studentId);
+        for (size_t i = undo.size(); i-- > 0;) {
+            if (index.roomSlot(undo[i].roomNumber) != HostelIndex::npos) place(undo[i]);
+        }
+        return false;
+    }
+
+    committed = move(releases);
+    committed.insert(committed.end(), placements.begin(), placements.end());
+    return true;
+}
+
+void AllocationTransaction::abort() {
+    staged.clear();
+}
+
+const vector<AllocationTransaction::Step>& AllocationTransaction::committedSteps() const {
+    return committed;
+}
+
+// Steps, applied through the index so buckets, counters and versions follow
+bool AllocationTransaction::place(const Step& step) {
+    size_t roomSlot = index.roomSlot(step.roomNumber);
+    if (!index.reserveBed(roomSlot)) return false;
+    if (!index.commitOccupant(rooms, roomSlot, step.studentId)) {
+        index.cancelReservation(roomSlot);
+        return false;
+    }
+    size_t studentSlot = index.studentSlot(step.studentId);
+    students[studentSlot].setRoomKey(step.roomNumber);
+    index.studentChanged(students, studentSlot);
+    return true;
+}
+
+void AllocationTransaction::release(StudentKey studentId) {
+    size_t studentSlot = index.studentSlot(studentId);
+    size_t roomSlot = index.roomSlot(students[studentSlot].getRoomKey());
+    if (roomSlot != HostelIndex::npos) index.removeOccupant(rooms, roomSlot, studentId);
+    students[studentSlot].setRoomKey(Keys::NONE);
+    index.studentChanged(students, studentSlot);
+}
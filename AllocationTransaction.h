@@ -0,0 +1,77 @@
+/**
+ * @file AllocationTransaction.h
+ * @brief All-or-Nothing Batches of Allocations and Deallocations
+ *
+ * A transaction collects allocate and deallocate steps without touching
+ * any record. commit() first validates the whole batch:
+ * - every student and room exists
+ * - a student is deallocated only if allocated, and allocated only if
+ *   unallocated or deallocated in the same batch (one step of each kind
+ *   per student at most), so a move is a deallocate plus an allocate
+ * - every room ends within its capacity, counting the beds the batch
+ *   frees as well as those it fills and any bed reserved elsewhere
+ *
+ * and only then applies it, deallocations first, so swaps and cycles
+ * among full rooms go through. Should a step still fail, the steps
+ * already applied are undone and the records are as they were before.
+ *
+ * After a successful commit, committedSteps() lists the steps in the
+ * order they were applied; HostelManager::commitTransaction journals
+ * them as one record.
+ *
+ * Like the Admin allocation methods it works on the caller's vectors and
+ * index and must be serialised with every other writer.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ALLOCATIONTRANSACTION_H
+#define ALLOCATIONTRANSACTION_H
+
+#include "Student.h"
+#include "Room.h"
+#include "HostelIndex.h"
+#include "Keys.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class AllocationTransaction {
+public:
+    struct Step {
+        StudentKey studentId;
+        RoomKey roomNumber;   // Keys::NONE for a deallocation
+    };
+
+private:
+    vector<Student>& students;
+    vector<Room>& rooms;
+    HostelIndex& index;
+    vector<Step> staged;
+    vector<Step> committed;
+
+    bool validate(vector<Step>& releases, vector<Step>& placements) const;
+    bool place(const Step& step);
+    void release(StudentKey studentId);
+
+public:
+    AllocationTransaction(vector<Student>& students, vector<Room>& rooms, HostelIndex& index);
+
+    // Staging (nothing is checked or changed until commit)
+    void stageAllocate(StudentKey studentId, RoomKey roomNumber);
+    void stageDeallocate(StudentKey studentId);
+    size_t size() const;
+
+    // Applies every staged step or none; prints the reason on failure.
+    // Either way the staged steps are dropped
+    bool commit();
+    void abort();
+
+    // Steps of the last successful commit, deallocations first
+    const vector<Step>& committedSteps() const;
+};
+
+#endif // ALLOCATIONTRANSACTION_H
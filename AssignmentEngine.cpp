@@ -0,0 +1,282 @@
+#include "AssignmentEngine.h"
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+using namespace std;
+
+namespace {
+    // Min-cost flow over a static graph. Arcs are collected in pairs
+    // (forward, residual) and then laid out in CSR order, so the arcs
+    // leaving a node are contiguous and each knows its partner's position.
+    class MinCostFlow {
+    private:
+        struct Arc {
+            int to;
+            int rev;    // position of the partner arc
+            int cap;
+            int cost;
+        };
+
+        int nodeCount;
+        vector<int> pendingFrom;    // arcs as added, before layout
+        vector<Arc> pending;
+        vector<int> position;       // added arc -> CSR position
+        vector<int> adjStart;       // arcs leaving v: arcs[adjStart[v] .. adjStart[v + 1])
+        vector<Arc> arcs;
+        vector<long long> potential;
+
+        static constexpr long long INF = numeric_limits<long long>::max() / 4;
+
+        void layout() {
+            adjStart.assign(nodeCount + 1, 0);
+            for (int from : pendingFrom) adjStart[from + 1]++;
+            for (int v = 0; v < nodeCount; ++v) adjStart[v + 1] += adjStart[v];
+            vector<int> fillPos(adjStart.begin(), adjStart.end() - 1);
+            position.resize(pending.size());
+            for (size_t e = 0; e < pending.size(); ++e) position[e] = fillPos[pendingFrom[e]]++;
+            arcs.resize(pending.size());
+            for (size_t e = 0; e < pending.size(); ++e) {
+                Arc arc = pending[e];
+                arc.rev = position[e ^ 1];
+                arcs[position[e]] = arc;
+            }
+            vector<int>().swap(pendingFrom);
+            vector<Arc>().swap(pending);
+        }
+
+        // Shortest reduced-cost distances from source; costs are small
+        // non-negative integers, so a bucket queue beats a binary heap
+        bool dijkstra(int source, int sink) {
+            vector<long long> dist(nodeCount, INF);
+            vector<vector<int>> buckets(1);
+            dist[source] = 0;
+            buckets[0].push_back(source);
+            for (size_t d = 0; d < buckets.size(); ++d) {
+                // Everything still unsettled would be capped at dist[sink] anyway
+                if (static_cast<long long>(d) >= dist[sink]) break;
+                for (size_t i = 0; i < buckets[d].size(); ++i) {
+                    int u = buckets[d][i];
+                    if (dist[u] != static_cast<long long>(d)) continue; // stale entry
+                    long long base = static_cast<long long>(d) + potential[u];
+                    for (int k = adjStart[u]; k < adjStart[u + 1]; ++k) {
+                        const Arc& arc = arcs[k];
+                        if (arc.cap <= 0) continue;
+                        long long nd = base + arc.cost - potential[arc.to];
+                        if (nd >= dist[arc.to]) continue;
+                        dist[arc.to] = nd;
+                        if (buckets.size() <= static_cast<size_t>(nd)) buckets.resize(nd + 1);
+                        buckets[nd].push_back(arc.to);
+                    }
+                }
+                vector<int>().swap(buckets[d]);
+            }
+            if (dist[sink] == INF) return false;
+            // Capping at dist[sink] keeps every residual reduced cost >= 0
+            for (int v = 0; v < nodeCount; ++v) potential[v] += min(dist[v], dist[sink]);
+            return true;
+        }
+
+        // Pushes unit paths along zero reduced-cost arcs until none is left
+        long long blockingFlow(int source, int sink) {
+            long long cost = 0;
+            vector<int> level(nodeCount);
+            vector<int> nextArc(nodeCount);
+            vector<int> queue;
+            vector<int> path;       // arc positions from source
+            vector<int> pathNodes;  // tail node of each arc in path
+            queue.reserve(nodeCount);
+
+            while (true) {
+                fill(level.begin(), level.end(), -1);
+                queue.clear();
+                level[source] = 0;
+                queue.push_back(source);
+                for (size_t head = 0; head < queue.size(); ++head) {
+                    int u = queue[head];
+                    if (level[sink] >= 0 && level[u] >= level[sink]) break; // deeper nodes cannot lie on a shortest path
+                    for (int k = adjStart[u]; k < adjStart[u + 1]; ++k) {
+                        const Arc& arc = arcs[k];
+                        if (arc.cap > 0 && level[arc.to] < 0 &&
+                            arc.cost + potential[u] == potential[arc.to]) {
+                            level[arc.to] = level[u] + 1;
+                            queue.push_back(arc.to);
+                        }
+                    }
+                }
+                if (level[sink] < 0) return cost;
+
+                for (int v = 0; v < nodeCount; ++v) nextArc[v] = adjStart[v];
+                path.clear();
+                pathNodes.clear();
+                int u = source;
+                while (true) {
+                    if (u == sink) {
+                        // Every source arc has capacity 1, so each path carries 1
+                        for (int k : path) {
+                            arcs[k].cap -= 1;
+                            arcs[arcs[k].rev].cap += 1;
+                            cost += arcs[k].cost;
+                        }
+                        path.clear();
+                        pathNodes.clear();
+                        u = source;
+                        continue;
+                    }
+                    bool advanced = false;
+                    for (int& k = nextArc[u]; k < adjStart[u + 1]; ++k) {
+                        const Arc& arc = arcs[k];
+                        if (arc.cap > 0 && level[arc.to] == level[u] + 1 &&
+                            arc.cost + potential[u] == potential[arc.to]) {
+                            path.push_back(k);
+                            pathNodes.push_back(u);
+                            u = arc.to;
+                            advanced = true;
+                            break;
+                        }
+                    }
+                    if (advanced) continue;
+                    // Dead end: retreat and never come back through u this round
+                    level[u] = -1;
+                    if (path.empty()) break;
+                    u = pathNodes.back();
+                    path.pop_back();
+                    pathNodes.pop_back();
+                    ++nextArc[u];
+                }
+            }
+        }
+
+    public:
+        explicit MinCostFlow(int nodes) : nodeCount(nodes) {}
+
+        // Returns a handle for flow() and head(); valid once solve() ran
+        int addArc(int from, int to, int cap, int cost) {
+            int e = static_cast<int>(pending.size());
+            pendingFrom.push_back(from);
+            pending.push_back({to, 0, cap, cost});
+            pendingFrom.push_back(to);
+            pending.push_back({from, 0, 0, -cost});
+            return e;
+        }
+
+        long long solve(int source, int sink) {
+            layout();
+            potential.assign(nodeCount, 0);
+            long long cost = 0;
+            while (dijkstra(source, sink)) cost += blockingFlow(source, sink);
+            return cost;
+        }
+
+        int flow(int e) const { return arcs[arcs[position[e]].rev].cap; }
+        int head(int e) const { return arcs[position[e]].to; }
+    };
+
+    int rentBand(double rent, const vector<double>& cuts) {
+        return static_cast<int>(upper_bound(cuts.begin(), cuts.end(), rent) - cuts.begin());
+    }
+}
+
+AssignmentEngine::Plan AssignmentEngine::solve(const vector<Student>& students,
+                                               const HostelIndex& index) {
+    Plan plan;
+
+    vector<size_t> candidates;
+    for (size_t i = 0; i < students.size(); ++i) {
+        if (!students[i].getIsAllocated()) candidates.push_back(i);
+    }
+    // Free beds come from the room table's columns
+    const RoomTable& table = index.roomTable();
+    const int32_t* capacity = table.capacity();
+    const int32_t* occupancy = table.occupancy();
+    const double* rent = table.rent();
+    vector<size_t> openRooms;
+    vector<double> rents;
+    for (size_t r = 0; r < table.size(); ++r) {
+        if (capacity[r] > occupancy[r]) {
+            openRooms.push_back(r);
+            rents.push_back(rent[r]);
+        }
+    }
+    if (candidates.empty()) return plan;
+    if (openRooms.empty()) {
+        plan.unassigned = candidates.size();
+        return plan;
+    }
+
+    // Rent quartile boundaries among the rooms that can still take someone
+    sort(rents.begin(), rents.end());
+    vector<double> cuts;
+    for (int q = 1; q < 4; ++q) cuts.push_back(rents[rents.size() * q / 4]);
+
+    // Nodes: 0 source, 1 sink, 2 ANY, then students, then open rooms
+    const int source = 0, sink = 1, any = 2;
+    const int firstStudent = 3;
+    const int firstRoom = firstStudent + static_cast<int>(candidates.size());
+    MinCostFlow graph(firstRoom + static_cast<int>(openRooms.size()));
+
+    vector<int> roomNode(table.size(), -1);
+    for (size_t k = 0; k < openRooms.size(); ++k) {
+        size_t r = openRooms[k];
+        int node = firstRoom + static_cast<int>(k);
+        roomNode[r] = node;
+        graph.addArc(node, sink, capacity[r] - occupancy[r], rentBand(rent[r], cuts));
+    }
+    vector<int> anyArcs;
+    for (size_t k = 0; k < openRooms.size(); ++k) {
+        size_t r = openRooms[k];
+        anyArcs.push_back(graph.addArc(any, firstRoom + static_cast<int>(k), capacity[r] - occupancy[r], 0));
+    }
+
+    struct Choice { int arc; int rank; };
+    vector<vector<Choice>> choices(candidates.size());
+    vector<int> fallbackArc(candidates.size());
+    unordered_set<size_t> seen;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        const Student& student = students[candidates[c]];
+        int node = firstStudent + static_cast<int>(c);
+        int weight = 4 * (1 + max(1, student.getYear()));
+        graph.addArc(source, node, 1, 0);
+
+        seen.clear();
+        int rank = 0;
+        for (RoomKey roomNumber : student.getPreferenceKeys()) {
+            if (rank >= MAX_RANKS) break;
+            size_t slot = index.roomSlot(roomNumber);
+            int target = (slot != HostelIndex::npos) ? roomNode[slot] : -1;
+            if (target >= 0 && seen.insert(slot).second) {
+                choices[c].push_back({graph.addArc(node, target, 1, (rank + 1) * weight), rank});
+            }
+            ++rank; // unknown or full rooms still use up their rank
+        }
+        fallbackArc[c] = graph.addArc(node, any, 1, (MAX_RANKS + 1) * weight);
+        graph.addArc(node, sink, 1, (MAX_RANKS + 2) * weight);
+    }
+
+    plan.totalCost = graph.solve(source, sink);
+
+    // Beds routed through ANY are interchangeable (same cost), so hand
+    // them out in room order to the fallback students
+    vector<size_t> anyBeds;
+    for (size_t k = 0; k < anyArcs.size(); ++k) {
+        for (int n = graph.flow(anyArcs[k]); n > 0; --n) anyBeds.push_back(openRooms[k]);
+    }
+    size_t nextBed = 0;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        bool placed = false;
+        for (const auto& choice : choices[c]) {
+            if (graph.flow(choice.arc) > 0) {
+                size_t roomSlot = openRooms[graph.head(choice.arc) - firstRoom];
+                plan.assignments.push_back({candidates[c], roomSlot, choice.rank});
+                placed = true;
+                break;
+            }
+        }
+        if (!placed && graph.flow(fallbackArc[c]) > 0 && nextBed < anyBeds.size()) {
+            plan.assignments.push_back({candidates[c], anyBeds[nextBed++], -1});
+            placed = true;
+        }
+        if (!placed) plan.unassigned++;
+    }
+    return plan;
+}
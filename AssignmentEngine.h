@@ -0,0 +1,68 @@
+/**
+ * @file AssignmentEngine.h
+ * @brief Preference-Aware Optimal Room Assignment
+ *
+ * Solves the assignment of every unallocated student to a free bed as one
+ * min-cost flow problem instead of first-fit:
+ *
+ *   source -> student (1) -> preferred room (rank cost) -> sink (free beds)
+ *                         -> ANY (fallback cost) -> every room
+ *                         -> sink directly (unassigned cost)
+ *
+ * Costs are small integers, multiplied by a seniority weight (1 + year)
+ * so that losing a rank costs a senior more than a junior:
+ * - preferred room at rank r (0-based): 4 * (r + 1) * (1 + year)
+ * - any other room:                     4 * (MAX_RANKS + 1) * (1 + year)
+ * - no room:                            4 * (MAX_RANKS + 2) * (1 + year)
+ * - every bed also costs its rent band (0-3, quartiles of the free rooms'
+ *   rent); the factor 4 keeps rent a tie-breaker that never outweighs a
+ *   preference rank
+ *
+ * Because leaving a student out always costs more than the fallback, the
+ * optimum fills every free bed it can; when beds run out the juniors are
+ * the ones left over.
+ *
+ * The solver is primal-dual: Dijkstra over reduced costs with a bucket
+ * queue (costs are small integers), then Dinic-style blocking flow on the
+ * zero reduced-cost arcs, repeated until no augmenting path is left.
+ *
+ * The engine only plans; callers apply the plan with Admin::allocateRoom.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ASSIGNMENTENGINE_H
+#define ASSIGNMENTENGINE_H
+
+#include "Student.h"
+#include "HostelIndex.h"
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+class AssignmentEngine {
+public:
+    struct Assignment {
+        size_t studentSlot;
+        size_t roomSlot;
+        int rank;               // index in the student's preferences, -1 if none matched
+    };
+
+    struct Plan {
+        vector<Assignment> assignments; // ordered by student slot
+        size_t unassigned = 0;          // candidates left without a bed
+        long long totalCost = 0;
+    };
+
+    // Preferences past this rank are ignored
+    static const int MAX_RANKS = 10;
+
+    // Plans beds for every unallocated student among the free slots of
+    // the rooms in index.roomTable()
+    static Plan solve(const vector<Student>& students, const HostelIndex& index);
+};
+
+#endif // ASSIGNMENTENGINE_H
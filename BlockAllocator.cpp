@@ -0,0 +1,207 @@
+#include "BlockAllocator.h"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace {
+    // Below this many students per worker a thread costs more than it saves
+    const size_t MIN_STUDENTS_PER_THREAD = 4096;
+    const uint32_t ANY_BLOCK = 0xFFFFFFFFu;
+    const size_t NO_ROOM = static_cast<size_t>(-1);
+
+    // Best-fit bed picker over a set of rooms: rooms sit in buckets by
+    // free beds, and a room left behind in a bucket it no longer matches
+    // is dropped when it reaches the top (free beds only go down)
+    class BestFit {
+    private:
+        vector<vector<size_t>> buckets;
+
+    public:
+        void add(size_t room, int freeBeds) {
+            if (freeBeds <= 0) return;
+            if (buckets.size() <= static_cast<size_t>(freeBeds)) buckets.resize(freeBeds + 1);
+            buckets[freeBeds].push_back(room);
+        }
+
+        size_t take(vector<int>& freeBeds) {
+            for (size_t n = 1; n < buckets.size(); ++n) {
+                while (!buckets[n].empty()) {
+                    size_t room = buckets[n].back();
+                    buckets[n].pop_back();
+                    if (freeBeds[room] != static_cast<int>(n)) continue; // stale entry
+                    add(room, --freeBeds[room]);
+                    return room;
+                }
+            }
+            return NO_ROOM;
+        }
+    };
+
+    // Highest-ranked preferred room with a free bed, limited to one block
+    // unless only == ANY_BLOCK; returns the rank or -1
+    int preferredRoom(const Student& student, const HostelIndex& index, const uint32_t* block,
+                      uint32_t only, const vector<int>& freeBeds, size_t& room) {
+        const auto& preferences = student.getPreferenceKeys();
+        for (size_t rank = 0; rank < preferences.size(); ++rank) {
+            size_t slot = index.roomSlot(preferences[rank]);
+            if (slot == HostelIndex::npos) continue;
+            if (only != ANY_BLOCK && block[slot] != only) continue;
+            if (freeBeds[slot] <= 0) continue;
+            room = slot;
+            return static_cast<int>(rank);
+        }
+        return -1;
+    }
+}
+
+BlockAllocator::Plan BlockAllocator::plan(const vector<Student>& students, const HostelIndex& index,
+                                          uint32_t seed, size_t threads) {
+    Plan plan;
+
+    // Free beds per room and per block, from the room table's columns
+    const RoomTable& table = index.roomTable();
+    const int32_t* capacity = table.capacity();
+    const int32_t* occupancy = table.occupancy();
+    const uint32_t* block = table.block();
+    size_t blockCount = table.blocks().size();
+    vector<int> freeBeds(table.size());
+    vector<vector<size_t>> blockRooms(blockCount);
+    vector<long long> blockBeds(blockCount, 0);
+    for (size_t r = 0; r < table.size(); ++r) {
+        freeBeds[r] = max(0, capacity[r] - occupancy[r]);
+        if (freeBeds[r] == 0) continue;
+        blockRooms[block[r]].push_back(r);
+        blockBeds[block[r]] += freeBeds[r];
+    }
+
+    // Candidates in the same order as Admin::autoAllocateRooms
+    vector<size_t> candidates;
+    for (size_t i = 0; i < students.size(); ++i) {
+        if (!students[i].getIsAllocated()) candidates.push_back(i);
+    }
+    stable_sort(candidates.begin(), candidates.end(),
+        [&students](size_t a, size_t b) { return students[a].getYear() > students[b].getYear(); });
+    if (candidates.empty()) return plan;
+
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max<size_t>(1, min(threads, candidates.size() / MIN_STUDENTS_PER_THREAD));
+
+    // Home blocks (one preference lookup per student) are found on every
+    // thread, each over its own range of candidates
+    vector<uint32_t> home(candidates.size(), ANY_BLOCK);
+    auto findHomes = [&](size_t w) {
+        for (size_t c = candidates.size() * w / threads, last = candidates.size() * (w + 1) / threads;
+             c < last; ++c) {
+            size_t room;
+            if (preferredRoom(students[candidates[c]], index, block, ANY_BLOCK, freeBeds, room) >= 0) {
+                home[c] = block[room];
+            }
+        }
+    };
+    vector<thread> workers;
+    for (size_t w = 1; w < threads; ++w) workers.emplace_back(findHomes, w);
+    findHomes(0);
+    for (auto& worker : workers) worker.join();
+
+    // Cohorts hold positions in candidates; students with a usable
+    // preference go to that room's block
+    vector<vector<size_t>> cohorts(blockCount);
+    vector<size_t> floating;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        if (home[c] != ANY_BLOCK) cohorts[home[c]].push_back(c);
+        else floating.push_back(c);
+    }
+
+    // The rest are dealt round-robin over the blocks with beds to spare,
+    // in a seeded order (Fisher-Yates on mt19937, whose output is fixed
+    // by the standard, unlike std::shuffle)
+    vector<uint32_t> open;
+    vector<long long> spare(blockCount);
+    for (uint32_t b = 0; b < blockCount; ++b) {
+        spare[b] = blockBeds[b] - static_cast<long long>(cohorts[b].size());
+        if (blockBeds[b] > 0) plan.blocks++;
+        if (spare[b] > 0) open.push_back(b);
+    }
+    mt19937 rng(seed);
+    for (size_t i = open.size(); i > 1; --i) swap(open[i - 1], open[rng() % i]);
+    size_t turn = 0;
+    for (size_t c : floating) {
+        if (open.empty()) break; // left for the reconciliation pass
+        turn %= open.size();
+        uint32_t b = open[turn];
+        cohorts[b].push_back(c);
+        if (--spare[b] == 0) open.erase(open.begin() + turn);
+        else turn++;
+    }
+
+    // Partitions: largest cohorts first; a block's rooms and its
+    // students' results are written only by the worker that takes it
+    vector<uint32_t> work;
+    for (uint32_t b = 0; b < blockCount; ++b) {
+        if (blockBeds[b] > 0 && !cohorts[b].empty()) work.push_back(b);
+    }
+    stable_sort(work.begin(), work.end(),
+        [&cohorts](uint32_t a, uint32_t b) { return cohorts[a].size() > cohorts[b].size(); });
+
+    vector<size_t> roomOf(candidates.size(), NO_ROOM);
+    vector<int> rankOf(candidates.size(), -1);
+    atomic<size_t> nextBlock(0);
+    auto placeBlocks = [&]() {
+        for (size_t k = nextBlock++; k < work.size(); k = nextBlock++) {
+            uint32_t b = work[k];
+            vector<size_t>& cohort = cohorts[b];
+            sort(cohort.begin(), cohort.end()); // back into seniority order
+            BestFit fit;
+            for (size_t r : blockRooms[b]) fit.add(r, freeBeds[r]);
+            for (size_t c : cohort) {
+                size_t room;
+                int rank = preferredRoom(students[candidates[c]], index, block, b, freeBeds, room);
+                if (rank >= 0) {
+                    fit.add(room, --freeBeds[room]);
+                } else {
+                    room = fit.take(freeBeds);
+                    if (room == NO_ROOM) continue; // overflow
+                }
+                roomOf[c] = room;
+                rankOf[c] = rank;
+            }
+        }
+    };
+    workers.clear();
+    for (size_t w = 1; w < min(threads, work.size()); ++w) workers.emplace_back(placeBlocks);
+    placeBlocks();
+    for (auto& worker : workers) worker.join();
+
+    // Reconciliation: overflow from every block, in seniority order,
+    // against the beds left anywhere
+    BestFit fit;
+    for (size_t r = 0; r < freeBeds.size(); ++r) fit.add(r, freeBeds[r]);
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        if (roomOf[c] != NO_ROOM) {
+            plan.placedInBlock++;
+            continue;
+        }
+        size_t room;
+        int rank = preferredRoom(students[candidates[c]], index, block, ANY_BLOCK, freeBeds, room);
+        if (rank >= 0) {
+            fit.add(room, --freeBeds[room]);
+        } else {
+            room = fit.take(freeBeds);
+            if (room == NO_ROOM) {
+                plan.unassigned++;
+                continue;
+            }
+        }
+        roomOf[c] = room;
+        rankOf[c] = rank;
+        plan.placedByOverflow++;
+    }
+
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        if (roomOf[c] != NO_ROOM) plan.assignments.push_back({candidates[c], roomOf[c], rankOf[c]});
+    }
+    return plan;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file BlockAllocator.h
+ * @brief Parallel Auto-Allocation Partitioned by Block
+ *
+ * Blocks are independent, so the free beds of each block are planned on
+ * their own worker thread:
+ *
+ * 1. Cohorts: every unallocated student (seniors first, as in
+ *    Admin::autoAllocateRooms) joins the block of their highest-ranked
+ *    preferred room that still has a free bed. Students without one are
+ *    dealt round-robin over the blocks that have beds to spare, visiting
+ *    the blocks in an order shuffled by the seed.
+ * 2. Partitions: each worker takes whole blocks and places the cohort in
+ *    order, first in a preferred room of the block, otherwise best fit
+ *    (the fullest room that still has a bed). Students the block cannot
+ *    hold go to its overflow list.
+ * 3. Reconciliation: the overflow lists are merged back into seniority
+ *    order and placed on one thread against the beds left anywhere,
+ *    preferred rooms first, then best fit.
+ *
+ * A block's rooms are only ever touched by the worker that owns it and
+ * the results are merged in a fixed order, so the plan depends on the
+ * data and the seed but not on the number of threads.
+ *
+ * The allocator only plans; callers apply the plan with
+ * Admin::allocateRoom.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef BLOCKALLOCATOR_H
+#define BLOCKALLOCATOR_H
+
+#include "Student.h"
+#include "HostelIndex.h"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+class BlockAllocator {
+public:
+    struct Assignment {
+        size_t studentSlot;
+        size_t roomSlot;
+        int rank;               // index in the student's preferences, -1 if none matched
+    };
+
+    struct Plan {
+        vector<Assignment> assignments; // seniors first, then by student slot
+        size_t blocks = 0;              // partitions with free beds
+        size_t placedInBlock = 0;       // placed by a partition worker
+        size_t placedByOverflow = 0;    // placed by the reconciliation pass
+        size_t unassigned = 0;          // candidates left without a bed
+    };
+
+    // Seed used when the caller does not give one
+    static const uint32_t DEFAULT_SEED = 1;
+
+    // Plans beds for every unallocated student among the free slots of
+    // the rooms in index.roomTable(); threads = 0 picks one per core
+    static Plan plan(const vector<Student>& students, const HostelIndex& index,
+                     uint32_t seed, size_t threads);
+};
+
+#endif // BLOCKALLOCATOR_H
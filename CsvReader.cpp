@@ -0,0 +1,226 @@
+#include "CsvReader.h"
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// MappedFile
+#ifdef _WIN32
+MappedFile::MappedFile() : bytes(nullptr), length(0), mapped(false),
+                           fileHandle(nullptr), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : bytes(nullptr), length(0), mapped(false) {}
+#endif
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+void MappedFile::release() {
+#ifdef _WIN32
+    if (mapped) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (mapped) munmap(const_cast<char*>(bytes), length);
+#endif
+    bytes = nullptr;
+    length = 0;
+    mapped = false;
+    fallback.clear();
+}
+
+bool MappedFile::open(const string& filename) {
+    release();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view) {
+                fileHandle = file;
+                mappingHandle = mapping;
+                bytes = static_cast<const char*>(view);
+                length = static_cast<size_t>(fileSize.QuadPart);
+                mapped = true;
+                return true;
+            }
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED) {
+            madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            ::close(fd);
+            bytes = static_cast<const char*>(view);
+            length = static_cast<size_t>(info.st_size);
+            mapped = true;
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+    // Empty file or mapping refused: read it in one go instead
+    ifstream in(filename, ios::binary);
+    if (!in.is_open()) return false;
+    ostringstream contents;
+    contents << in.rdbuf();
+    fallback = contents.str();
+    bytes = fallback.data();
+    length = fallback.size();
+    return true;
+}
+
+const char* MappedFile::data() const { return bytes; }
+size_t MappedFile::size() const { return length; }
+string_view MappedFile::view() const { return string_view(bytes, length); }
+
+// CsvCursor
+CsvCursor::CsvCursor(const char* begin, const char* end) : pos(begin), end(end) {}
+
+CsvCursor::CsvCursor(string_view text) : pos(text.data()), end(text.data() + text.size()) {}
+
+const char* CsvCursor::position() const { return pos; }
+
+bool CsvCursor::next(vector<string_view>& fields) {
+    fields.clear();
+    if (pos >= end) return false;
+
+    size_t fieldNo = 0;
+    while (true) {
+        const char* start = pos;
+        // Fast path: an unquoted field is a view straight into the buffer
+        while (pos < end && *pos != ',' && *pos != '\n' && *pos != '"') ++pos;
+
+        if (pos < end && *pos == '"') {
+            // Quoted (or partly quoted) field: unescape into scratch storage
+            if (scratch.size() <= fieldNo) scratch.resize(fieldNo + 1);
+            string& buf = scratch[fieldNo];
+            buf.assign(start, pos);
+            bool inQuotes = false;
+            while (pos < end) {
+                char c = *pos;
+                if (inQuotes) {
+                    if (c == '"') {
+                        if (pos + 1 < end && pos[1] == '"') {
+                            buf.push_back('"');
+                            pos += 2; // skip escaped quote
+                            continue;
+                        }
+                        inQuotes = false;
+                    } else {
+                        buf.push_back(c);
+                    }
+                } else {
+                    if (c == ',' || c == '\n') break;
+                    if (c == '"') inQuotes = true;
+                    else buf.push_back(c);
+                }
+                ++pos;
+            }
+            fields.push_back(csvTrimView(buf));
+        } else {
+            fields.push_back(csvTrimView(string_view(start, static_cast<size_t>(pos - start))));
+        }
+
+        ++fieldNo;
+        if (pos >= end) break;
+        if (*pos == '\n') {
+            ++pos;
+            break;
+        }
+        ++pos; // skip ','
+    }
+    return true;
+}
+
+// Parallel chunking
+vector<string_view> csvSplitChunks(string_view text, size_t parts) {
+    vector<string_view> chunks;
+    if (text.empty()) return chunks;
+    if (parts < 2) {
+        chunks.push_back(text);
+        return chunks;
+    }
+
+    // Count quotes per raw slice in parallel to learn the quoted state at
+    // every slice start
+    size_t sliceSize = (text.size() + parts - 1) / parts;
+    vector<size_t> quotes(parts, 0);
+    vector<thread> counters;
+    for (size_t i = 0; i < parts; ++i) {
+        counters.emplace_back([&text, &quotes, sliceSize, i]() {
+            size_t begin = min(text.size(), i * sliceSize);
+            size_t end = min(text.size(), begin + sliceSize);
+            size_t n = 0;
+            for (size_t p = begin; p < end; ++p) if (text[p] == '"') ++n;
+            quotes[i] = n;
+        });
+    }
+    for (auto& counter : counters) counter.join();
+
+    // Move each raw cut forward to the first newline outside quotes
+    size_t start = 0;
+    size_t quotesBefore = 0;
+    for (size_t i = 0; i + 1 < parts; ++i) {
+        quotesBefore += quotes[i];
+        size_t cut = min(text.size(), (i + 1) * sliceSize);
+        if (cut <= start) continue;
+        bool inQuotes = (quotesBefore % 2) == 1;
+        while (cut < text.size() && (inQuotes || text[cut] != '\n')) {
+            if (text[cut] == '"') inQuotes = !inQuotes;
+            ++cut;
+        }
+        if (cut >= text.size()) break;
+        ++cut; // keep the newline with the record it ends
+        chunks.push_back(text.substr(start, cut - start));
+        start = cut;
+    }
+    if (start < text.size()) chunks.push_back(text.substr(start));
+    return chunks;
+}
+
+// Field conversions
+string_view csvTrimView(string_view s) {
+    size_t start = s.find_first_not_of(" \t\r\n");
+    if (start == string_view::npos) return string_view();
+    size_t end = s.find_last_not_of(" \t\r\n");
+    return s.substr(start, end - start + 1);
+}
+
+int csvToInt(string_view s) {
+    s = csvTrimView(s);
+    int value = 0;
+    if (from_chars(s.data(), s.data() + s.size(), value).ec != errc()) return 0;
+    return value;
+}
+
+double csvToDouble(string_view s) {
+    s = csvTrimView(s);
+    double value = 0.0;
+    if (from_chars(s.data(), s.data() + s.size(), value).ec != errc()) return 0.0;
+    return value;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file CsvReader.h
+ * @brief Zero-Copy CSV Reader for Bulk Loading
+ *
+ * MappedFile maps a whole file into memory (mmap on POSIX, a file
+ * mapping on Windows, a single read as fallback). CsvCursor tokenises the
+ * mapped bytes in place and hands out string_view fields, so loading a
+ * row allocates nothing beyond the strings the record itself owns.
+ *
+ * Quoting rules are the same as csvParseLine():
+ * - '"' toggles quoting, "" inside quotes is a literal quote
+ * - ',' and newlines inside quotes are part of the field
+ * - fields are trimmed of surrounding whitespace after unquoting
+ *
+ * csvSplitChunks() cuts a buffer into record-aligned chunks for parallel
+ * parsing. Every '"' toggles the quoted state (an escaped "" toggles it
+ * twice), so the state at any offset is the parity of the quotes before
+ * it; chunks only end at newlines that fall outside quotes.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+class MappedFile {
+private:
+    const char* bytes;
+    size_t length;
+    bool mapped;          // true when bytes come from an OS mapping
+    string fallback;      // owns the bytes when mapping is unavailable
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    void release();
+
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const string& filename);
+    const char* data() const;
+    size_t size() const;
+    string_view view() const;
+};
+
+class CsvCursor {
+private:
+    const char* pos;
+    const char* end;
+    deque<string> scratch; // unescaped quoted fields; deque keeps earlier views valid on growth
+
+public:
+    CsvCursor(const char* begin, const char* end);
+    explicit CsvCursor(string_view text);
+
+    // Fills fields with the next record; views stay valid until the next call
+    bool next(vector<string_view>& fields);
+    const char* position() const;
+};
+
+// Splits text into at most parts record-aligned chunks, in file order
+vector<string_view> csvSplitChunks(string_view text, size_t parts);
+
+// Parses every chunk on its own thread into Record objects (anything with
+// loadFromFields); results come back per chunk, in file order. Each chunk
+// fills records copied from makeRecord(), called once on its own thread,
+// so a chunk can be given its own memory
+template <typename Record, typename MakeRecord>
+vector<vector<Record>> csvParseParallel(string_view text, size_t threads, MakeRecord makeRecord) {
+    vector<string_view> chunks = csvSplitChunks(text, threads);
+    vector<vector<Record>> parts(chunks.size());
+    auto parseChunk = [&chunks, &parts, &makeRecord](size_t i) {
+        CsvCursor cursor(chunks[i]);
+        vector<string_view> fields;
+        Record record = makeRecord();
+        while (cursor.next(fields)) {
+            if (record.loadFromFields(fields)) parts[i].push_back(move(record));
+        }
+    };
+    vector<thread> workers;
+    for (size_t i = 1; i < chunks.size(); ++i) workers.emplace_back(parseChunk, i);
+    if (!chunks.empty()) parseChunk(0);
+    for (auto& worker : workers) worker.join();
+    return parts;
+}
+
+// Field conversions shared by the loaders (invalid input yields 0)
+string_view csvTrimView(string_view s);
+int csvToInt(string_view s);
+double csvToDouble(string_view s);
+
+#endif // CSVREADER_H
@@ -0,0 +1,83 @@
+#include "CsvUtils.h"
+
+using namespace std;
+
+string csvTrim(const string& s) {
+    size_t start = s.find_first_not_of(" \t\r\n");
+    if (start == string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r\n");
+    return s.substr(start, end - start + 1);
+}
+
+string csvEscape(const string& value) {
+    bool needsQuotes = value.find_first_of(",\"\n") != string::npos;
+    string out = value;
+    // Escape quotes by doubling them
+    size_t pos = 0;
+    while ((pos = out.find('"', pos)) != string::npos) {
+        out.insert(pos, 1, '"');
+        pos += 2;
+    }
+    if (needsQuotes) return string("\"") + out + string("\"");
+    return out;
+}
+
+ostream& csvWrite(ostream& os, string_view value) {
+    if (value.find_first_of(",\"\n") == string_view::npos) {
+        return os.write(value.data(), static_cast<streamsize>(value.size()));
+    }
+    os.put('"');
+    for (char c : value) {
+        if (c == '"') os.put('"');
+        os.put(c);
+    }
+    return os.put('"');
+}
+
+vector<string> csvParseLine(const string& line) {
+    vector<string> result;
+    string cur;
+    bool inQuotes = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (inQuotes) {
+            if (c == '"') {
+                if (i + 1 < line.size() && line[i + 1] == '"') {
+                    cur.push_back('"');
+                    ++i; // skip escaped quote
+                } else {
+                    inQuotes = false;
+                }
+            } else {
+                cur.push_back(c);
+            }
+        } else {
+            if (c == ',') {
+                result.push_back(cur);
+                cur.clear();
+            } else if (c == '"') {
+                inQuotes = true;
+            } else {
+                cur.push_back(c);
+            }
+        }
+    }
+    result.push_back(cur);
+    for (auto& t : result) t = csvTrim(t);
+    return result;
+}
+
+bool csvReadRecord(istream& is, string& record) {
+    if (!getline(is, record)) return false;
+    // Every quote toggles the quoted state ("" toggles twice), so an odd
+    // count means a quoted field continues on the next physical line
+    size_t quotes = 0;
+    for (char c : record) if (c == '"') ++quotes;
+    string line;
+    while (quotes % 2 == 1 && getline(is, line)) {
+        record += '\n';
+        record += line;
+        for (char c : line) if (c == '"') ++quotes;
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file CsvUtils.h
+ * @brief Shared CSV Helpers for Hostel Allotment System
+ *
+ * Quoting, tokenising and record reading used by every CSV reader and
+ * writer in the system (students, rooms, admins and the journal).
+ *
+ * Quoting rules:
+ * - Fields containing ',', '"' or a newline are wrapped in quotes
+ * - Embedded quotes are doubled
+ * - Tokens are trimmed of surrounding whitespace after unquoting
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef CSVUTILS_H
+#define CSVUTILS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+
+string csvTrim(const string& s);
+string csvEscape(const string& value);
+// Writes one field quoted as csvEscape would, straight to the stream
+ostream& csvWrite(ostream& os, string_view value);
+vector<string> csvParseLine(const string& line);
+
+// Reads one logical record, joining physical lines while a quoted field
+// is still open (csvEscape quotes fields that contain newlines)
+bool csvReadRecord(istream& is, string& record);
+
+#endif // CSVUTILS_H
@@ -0,0 +1,99 @@
+#include "DataVersions.h"
+#include <algorithm>
+#include <atomic>
+
+using namespace std;
+
+namespace {
+    // Leaves to re-copy: those holding a touched slot, plus every leaf from
+    // the first shifted slot or the old end (appends grow the last leaf)
+    vector<size_t> staleLeaves(const vector<size_t>& touched, size_t shiftedFrom, size_t oldCount,
+                               size_t newCount, size_t leafRecords) {
+        size_t from = min(shiftedFrom, oldCount) / leafRecords;
+        size_t end = (newCount + leafRecords - 1) / leafRecords;
+        vector<size_t> leaves;
+        for (size_t slot : touched) {
+            if (slot / leafRecords < from) leaves.push_back(slot / leafRecords);
+        }
+        sort(leaves.begin(), leaves.end());
+        leaves.erase(unique(leaves.begin(), leaves.end()), leaves.end());
+        for (size_t leaf = from; leaf < end; ++leaf) leaves.push_back(leaf);
+        return leaves;
+    }
+}
+
+// Records
+template <typename T>
+void VersionedRecords<T>::refresh(const vector<T>& records, const vector<size_t>& staleLeaves) {
+    count = records.size();
+    size_t leaves = (count + LEAF_RECORDS - 1) / LEAF_RECORDS;
+    size_t groupCount = (leaves + LEAF_FANOUT - 1) / LEAF_FANOUT;
+    groups.resize(groupCount);
+
+    size_t i = 0;
+    while (i < staleLeaves.size() && staleLeaves[i] < leaves) {
+        // Copy-on-write: the group is copied once, then its stale leaves
+        size_t g = staleLeaves[i] / LEAF_FANOUT;
+        shared_ptr<Group> group = groups[g] ? make_shared<Group>(*groups[g]) : make_shared<Group>();
+        group->resize(min(LEAF_FANOUT, leaves - g * LEAF_FANOUT));
+        for (; i < staleLeaves.size() && staleLeaves[i] < leaves && staleLeaves[i] / LEAF_FANOUT == g; ++i) {
+            size_t first = staleLeaves[i] * LEAF_RECORDS;
+            size_t last = min(count, first + LEAF_RECORDS);
+            (*group)[staleLeaves[i] % LEAF_FANOUT] =
+                make_shared<const Leaf>(records.begin() + first, records.begin() + last);
+        }
+        groups[g] = move(group);
+    }
+}
+
+template class VersionedRecords<Student>;
+template class VersionedRecords<Room>;
+
+// Versions
+DataVersions::DataVersions() : studentsShiftedFrom(NO_SLOT), roomsShiftedFrom(NO_SLOT) {}
+
+void DataVersions::studentChanged(size_t slot) {
+    if (active) touchedStudents.push_back(slot);
+}
+
+void DataVersions::studentsShifted(size_t fromSlot) {
+    if (active) studentsShiftedFrom = min(studentsShiftedFrom, fromSlot);
+}
+
+void DataVersions::roomChanged(size_t slot) {
+    if (active) touchedRooms.push_back(slot);
+}
+
+void DataVersions::roomsShifted(size_t fromSlot) {
+    if (active) roomsShiftedFrom = min(roomsShiftedFrom, fromSlot);
+}
+
+void DataVersions::publish(const vector<Student>& students, const vector<Room>& rooms,
+                           const ReportSummary& live) {
+    shared_ptr<const DataVersion> previous = pin();
+    if (previous && touchedStudents.empty() && touchedRooms.empty() &&
+        studentsShiftedFrom == NO_SLOT && roomsShiftedFrom == NO_SLOT &&
+        previous->students.size() == students.size() && previous->rooms.size() == rooms.size()) {
+        return;
+    }
+
+    // The copy shares every group of the previous version until refreshed
+    shared_ptr<DataVersion> next = previous ? make_shared<DataVersion>(*previous) : make_shared<DataVersion>();
+    next->number++;
+    next->students.refresh(students, staleLeaves(touchedStudents, studentsShiftedFrom, next->students.size(),
+                                                 students.size(), VersionedRecords<Student>::LEAF_RECORDS));
+    next->rooms.refresh(rooms, staleLeaves(touchedRooms, roomsShiftedFrom, next->rooms.size(),
+                                           rooms.size(), VersionedRecords<Room>::LEAF_RECORDS));
+    next->live = live;
+    atomic_store(&current, shared_ptr<const DataVersion>(move(next)));
+
+    active = true;
+    touchedStudents.clear();
+    touchedRooms.clear();
+    studentsShiftedFrom = NO_SLOT;
+    roomsShiftedFrom = NO_SLOT;
+}
+
+shared_ptr<const DataVersion> DataVersions::pin() const {
+    return atomic_load(&current);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file DataVersions.h
+ * @brief Immutable, Structurally Shared Versions of the Records for Readers
+ *
+ * A DataVersion is a read-only copy of every student and room as they
+ * stood after one commit, together with the live report counters of that
+ * moment. A reader pins the current version (a shared_ptr) and can then
+ * scan it for as long as it likes without holding any lock: writers never
+ * change a published version, they publish the next one.
+ *
+ * Records are copied in leaves of LEAF_RECORDS, LEAF_FANOUT leaves to a
+ * group. publish() copies only the leaves whose records changed since the
+ * previous version (the HostelIndex hooks mark them), plus the groups and
+ * the top-level list that lead to them; every other leaf and group is
+ * shared with the previous version. A commit touching one student and one
+ * room copies two leaves and a few hundred pointers, whatever the size of
+ * the hostel.
+ *
+ * A version is freed when the last reader pinning it lets go (the
+ * shared_ptr count), so a long report keeps exactly the leaves it started
+ * with alive and never holds up a writer.
+ *
+ * Nothing is kept until the first publish(); until then the hooks return
+ * at once. publish() calls must be serialised with every write to the
+ * records; pin() may run on any thread at any time.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef DATAVERSIONS_H
+#define DATAVERSIONS_H
+
+#include "Student.h"
+#include "Room.h"
+#include "ReportEngine.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// One table's records in a version; a slot is read through its group and leaf
+template <typename T>
+class VersionedRecords {
+public:
+    static constexpr size_t LEAF_RECORDS = 64;
+    static constexpr size_t LEAF_FANOUT = 64;
+    typedef vector<T> Leaf;
+    typedef vector<shared_ptr<const Leaf>> Group;
+
+    size_t size() const { return count; }
+    const T& operator[](size_t slot) const {
+        size_t leaf = slot / LEAF_RECORDS;
+        return (*(*groups[leaf / LEAF_FANOUT])[leaf % LEAF_FANOUT])[slot % LEAF_RECORDS];
+    }
+
+    // Re-copies the listed leaves (ascending, no repeats) from records and
+    // keeps sharing the others; the size follows records
+    void refresh(const vector<T>& records, const vector<size_t>& staleLeaves);
+
+private:
+    size_t count = 0;
+    vector<shared_ptr<const Group>> groups;
+};
+
+struct DataVersion {
+    uint64_t number = 0;    // 1 for the first publish, then one per change
+    VersionedRecords<Student> students;
+    VersionedRecords<Room> rooms;
+    ReportSummary live;     // the live counters (HostelStats) when published
+};
+
+class DataVersions {
+private:
+    shared_ptr<const DataVersion> current; // swapped with atomic_store
+    bool active = false;
+    // Slots changed since the last publish, and the first slot from which
+    // every record moved (erase, reorder); NO_SLOT when none did
+    vector<size_t> touchedStudents, touchedRooms;
+    size_t studentsShiftedFrom, roomsShiftedFrom;
+
+public:
+    static const size_t NO_SLOT = static_cast<size_t>(-1);
+
+    DataVersions();
+
+    // Hooks (no-ops until the first publish)
+    void studentChanged(size_t slot);
+    void studentsShifted(size_t fromSlot);
+    void roomChanged(size_t slot);
+    void roomsShifted(size_t fromSlot);
+
+    // Makes the records as they are now the current version; nothing is
+    // copied if no hook fired since the last call
+    void publish(const vector<Student>& students, const vector<Room>& rooms, const ReportSummary& live);
+    // The current version, or null before the first publish
+    shared_ptr<const DataVersion> pin() const;
+};
+
+#endif // DATAVERSIONS_H
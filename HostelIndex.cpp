@@ -0,0 +1,328 @@
+#include "HostelIndex.h"
+#include <algorithm>
+
+using namespace std;
+
+// Full rebuilds
+void HostelIndex::rebuild(const vector<Student>& students, const vector<Room>& rooms) {
+    rebuildStudents(students);
+    rebuildRooms(rooms);
+    resolveOccupants(rooms);
+}
+
+void HostelIndex::rebuildStudents(const vector<Student>& students) {
+    studentSlots.clear();
+    studentSlots.reserve(students.size());
+    stats.resetStudents();
+    search.reset();
+    versions.studentsShifted(0);
+    for (size_t i = 0; i < students.size(); ++i) {
+        studentSlots[students[i].getKey()] = i;
+        stats.studentAppended(students[i]);
+    }
+}
+
+void HostelIndex::rebuildRooms(const vector<Room>& rooms) {
+    roomSlots.clear();
+    roomSlots.reserve(rooms.size());
+    for (size_t i = 0; i < rooms.size(); ++i) {
+        roomSlots[rooms[i].getKey()] = i;
+    }
+    rebuildBuckets(rooms);
+    table.rebuild(rooms);
+    reservations.rebuild(rooms);
+    versions.roomsShifted(0);
+    stats.resetRooms();
+    for (size_t i = 0; i < rooms.size(); ++i) stats.addRoom(table, i);
+}
+
+void HostelIndex::resolveOccupants(const vector<Room>& rooms) {
+    table.resolveOccupants(rooms, studentSlots);
+}
+
+// Lookups
+Student* HostelIndex::findStudent(vector<Student>& students, StudentKey studentId) const {
+    size_t slot = studentSlot(studentId);
+    return (slot != npos && slot < students.size()) ? &students[slot] : nullptr;
+}
+
+Room* HostelIndex::findRoom(vector<Room>& rooms, RoomKey roomNumber) const {
+    size_t slot = roomSlot(roomNumber);
+    return (slot != npos && slot < rooms.size()) ? &rooms[slot] : nullptr;
+}
+
+bool HostelIndex::hasStudent(StudentKey studentId) const {
+    return studentSlots.count(studentId) > 0;
+}
+
+bool HostelIndex::hasRoom(RoomKey roomNumber) const {
+    return roomSlots.count(roomNumber) > 0;
+}
+
+size_t HostelIndex::studentSlot(StudentKey studentId) const {
+    auto it = studentSlots.find(studentId);
+    return (it != studentSlots.end()) ? it->second : npos;
+}
+
+size_t HostelIndex::roomSlot(RoomKey roomNumber) const {
+    auto it = roomSlots.find(roomNumber);
+    return (it != roomSlots.end()) ? it->second : npos;
+}
+
+// Incremental maintenance
+void HostelIndex::studentAppended(const vector<Student>& students) {
+    if (students.empty()) return;
+    studentSlots[students.back().getKey()] = students.size() - 1;
+    stats.studentAppended(students.back());
+    search.studentAppended(students.back());
+}
+
+void HostelIndex::studentErased(const vector<Student>& students, size_t slot,
+                                StudentKey studentId) {
+    // The record is already gone from the vector; every later slot shifted down
+    studentSlots.erase(studentId);
+    for (size_t i = slot; i < students.size(); ++i) {
+        studentSlots[students[i].getKey()] = i;
+    }
+    table.studentErased(slot);
+    stats.studentErased(slot);
+    search.studentErased(slot);
+    versions.studentsShifted(slot);
+}
+
+void HostelIndex::studentRekeyed(StudentKey oldId, StudentKey newId) {
+    if (oldId == newId) return;
+    auto it = studentSlots.find(oldId);
+    if (it == studentSlots.end()) return;
+    size_t slot = it->second;
+    studentSlots.erase(it);
+    studentSlots[newId] = slot;
+}
+
+void HostelIndex::roomAppended(const vector<Room>& rooms) {
+    if (rooms.empty()) return;
+    size_t slot = rooms.size() - 1;
+    roomSlots[rooms.back().getKey()] = slot;
+    bucketOf.push_back(-1);
+    bucketPos.push_back(0);
+    bucketInsert(slot, rooms.back().getAvailableSlots());
+    table.append(rooms.back(), studentSlots);
+    reservations.append(rooms.back());
+    stats.addRoom(table, slot);
+}
+
+void HostelIndex::roomErased(const vector<Room>& rooms, size_t slot,
+                             RoomKey roomNumber) {
+    roomSlots.erase(roomNumber);
+    for (size_t i = slot; i < rooms.size(); ++i) {
+        roomSlots[rooms[i].getKey()] = i;
+    }
+    // The table row still describes the erased room until the rebuild
+    stats.removeRoom(table, slot);
+    // Bucket entries and table rows follow slot numbers, which all shifted;
+    // erase is O(n) anyway
+    rebuildBuckets(rooms);
+    table.rebuild(rooms);
+    table.resolveOccupants(rooms, studentSlots);
+    reservations.rebuild(rooms);
+    versions.roomsShifted(slot);
+}
+
+void HostelIndex::roomRekeyed(RoomKey oldNumber, RoomKey newNumber) {
+    if (oldNumber == newNumber) return;
+    auto it = roomSlots.find(oldNumber);
+    if (it == roomSlots.end()) return;
+    size_t slot = it->second;
+    roomSlots.erase(it);
+    roomSlots[newNumber] = slot;
+}
+
+void HostelIndex::studentChanged(const vector<Student>& students, size_t slot) {
+    if (slot >= students.size()) return;
+    stats.studentChanged(slot, students[slot]);
+    search.studentChanged(slot, students[slot]);
+    versions.studentChanged(slot);
+}
+
+void HostelIndex::roomChanged(const vector<Room>& rooms, size_t slot) {
+    if (slot >= rooms.size() || slot >= table.size()) return;
+    bucketRefresh(rooms, slot);
+    stats.removeRoom(table, slot);
+    table.update(rooms, slot, studentSlots);
+    reservations.update(slot, rooms[slot]);
+    stats.addRoom(table, slot);
+    versions.roomChanged(slot);
+}
+
+// Occupancy changes
+bool HostelIndex::addOccupant(vector<Room>& rooms, size_t slot, StudentKey studentId) {
+    if (!reserveBed(slot)) return false;
+    if (commitOccupant(rooms, slot, studentId)) return true;
+    cancelReservation(slot);
+    return false;
+}
+
+bool HostelIndex::removeOccupant(vector<Room>& rooms, size_t slot, StudentKey studentId) {
+    if (slot >= rooms.size() || !rooms[slot].removeOccupant(studentId)) return false;
+    reservations.release(slot);
+    bucketRefresh(rooms, slot);
+    stats.removeRoom(table, slot);
+    table.updateOccupants(rooms, slot, studentSlots);
+    stats.addRoom(table, slot);
+    versions.roomChanged(slot);
+    return true;
+}
+
+// Reservations
+bool HostelIndex::reserveBed(size_t slot) {
+    return reservations.reserve(slot);
+}
+
+void HostelIndex::cancelReservation(size_t slot) {
+    reservations.release(slot);
+}
+
+int32_t HostelIndex::claimedBeds(size_t slot) const {
+    return reservations.claimedBeds(slot);
+}
+
+// The reserved bed is already counted, so the claim simply stays
+bool HostelIndex::commitOccupant(vector<Room>& rooms, size_t slot, StudentKey studentId) {
+    if (slot >= rooms.size() || !rooms[slot].addOccupant(studentId)) return false;
+    bucketRefresh(rooms, slot);
+    stats.removeRoom(table, slot);
+    table.updateOccupants(rooms, slot, studentSlots);
+    stats.addRoom(table, slot);
+    versions.roomChanged(slot);
+    return true;
+}
+
+vector<string> HostelIndex::checkOccupancy(const vector<Student>& students, const vector<Room>& rooms,
+                                           bool reservationsIdle) const {
+    vector<string> drift;
+    for (size_t slot = 0; slot < rooms.size(); ++slot) {
+        const Room& room = rooms[slot];
+        const string number = room.getRoomNumber();
+        int occupancy = room.getCurrentOccupancy();
+        int claimed = reservations.claimedBeds(slot);
+        if (occupancy > room.getCapacity()) {
+            drift.push_back("room " + number + ": " + to_string(occupancy) + " occupants, capacity " +
+                            to_string(room.getCapacity()));
+        }
+        if (occupancy != static_cast<int>(room.getOccupantKeys().size())) {
+            drift.push_back("room " + number + ": occupancy " + to_string(occupancy) + ", " +
+                            to_string(room.getOccupantKeys().size()) + " listed");
+        }
+        if (claimed < occupancy || claimed > room.getCapacity() || (reservationsIdle && claimed != occupancy)) {
+            drift.push_back("room " + number + ": " + to_string(claimed) + " beds claimed, " +
+                            to_string(occupancy) + " occupied");
+        }
+        for (StudentKey occupant : room.getOccupantKeys()) {
+            size_t studentSlot = this->studentSlot(occupant);
+            if (studentSlot == npos || students[studentSlot].getRoomKey() != room.getKey()) {
+                drift.push_back("room " + number + ": occupant " + Keys::studentId(occupant) +
+                                " is not allocated to it");
+            }
+        }
+    }
+    for (const auto& student : students) {
+        if (!student.getIsAllocated()) continue;
+        size_t slot = roomSlot(student.getRoomKey());
+        const auto* occupants = (slot != npos) ? &rooms[slot].getOccupantKeys() : nullptr;
+        if (!occupants || find(occupants->begin(), occupants->end(), student.getKey()) == occupants->end()) {
+            drift.push_back("student " + student.getStudentId() + ": not listed in room " +
+                            Keys::roomNumber(student.getRoomKey()));
+        }
+    }
+    return drift;
+}
+
+// Availability queries
+size_t HostelIndex::findRoomWithSlots(int minFreeSlots) const {
+    // Best fit: the fullest room that still has room for the request, which
+    // keeps empty rooms free for groups
+    for (size_t n = static_cast<size_t>(max(minFreeSlots, 1)); n < freeBuckets.size(); ++n) {
+        if (!freeBuckets[n].empty()) return freeBuckets[n].back();
+    }
+    return npos;
+}
+
+size_t HostelIndex::countRoomsWithSlots(int minFreeSlots) const {
+    size_t count = 0;
+    for (size_t n = static_cast<size_t>(max(minFreeSlots, 1)); n < freeBuckets.size(); ++n) {
+        count += freeBuckets[n].size();
+    }
+    return count;
+}
+
+const RoomTable& HostelIndex::roomTable() const {
+    return table;
+}
+
+const HostelStats& HostelIndex::liveStats() const {
+    return stats;
+}
+
+SearchIndex::Page HostelIndex::searchStudents(const vector<Student>& students, string_view query,
+                                              unsigned fields, SearchIndex::Mode mode,
+                                              size_t offset, size_t limit) {
+    if (!search.isBuilt()) search.build(students);
+    return search.search(query, fields, mode, offset, limit);
+}
+
+void HostelIndex::prepareSearch(const vector<Student>& students) {
+    if (!search.isBuilt()) search.build(students);
+}
+
+const SearchIndex& HostelIndex::studentSearch() const {
+    return search;
+}
+
+// Record versions
+void HostelIndex::publishVersion(const vector<Student>& students, const vector<Room>& rooms) {
+    versions.publish(students, rooms, stats.summary(table));
+}
+
+shared_ptr<const DataVersion> HostelIndex::pinVersion() const {
+    return versions.pin();
+}
+
+// Bucket helpers
+void HostelIndex::bucketRefresh(const vector<Room>& rooms, size_t slot) {
+    if (slot >= rooms.size() || slot >= bucketOf.size()) return;
+    int freeSlots = rooms[slot].getAvailableSlots();
+    if (bucketOf[slot] == max(freeSlots, 0)) return;
+    bucketRemove(slot);
+    bucketInsert(slot, freeSlots);
+}
+
+void HostelIndex::bucketInsert(size_t slot, int freeSlots) {
+    size_t n = static_cast<size_t>(max(freeSlots, 0));
+    if (n >= freeBuckets.size()) freeBuckets.resize(n + 1);
+    bucketOf[slot] = static_cast<int>(n);
+    bucketPos[slot] = freeBuckets[n].size();
+    freeBuckets[n].push_back(slot);
+}
+
+void HostelIndex::bucketRemove(size_t slot) {
+    int n = bucketOf[slot];
+    if (n < 0) return;
+    // Swap with the bucket's last entry so removal is O(1)
+    vector<size_t>& bucket = freeBuckets[n];
+    size_t pos = bucketPos[slot];
+    size_t last = bucket.back();
+    bucket[pos] = last;
+    bucketPos[last] = pos;
+    bucket.pop_back();
+    bucketOf[slot] = -1;
+}
+
+void HostelIndex::rebuildBuckets(const vector<Room>& rooms) {
+    freeBuckets.clear();
+    bucketOf.assign(rooms.size(), -1);
+    bucketPos.assign(rooms.size(), 0);
+    // Insert in reverse so back() of each bucket is the lowest slot
+    for (size_t i = rooms.size(); i-- > 0; ) {
+        bucketInsert(i, rooms[i].getAvailableSlots());
+    }
+}
@@ -0,0 +1,146 @@
+/**
+ * @file HostelIndex.h
+ * @brief Lookup Index for Students and Rooms
+ *
+ * This class keeps hash indexes from student and room keys (see Keys.h)
+ * to the slot (vector position) of the matching record, so that a lookup costs
+ * O(1) instead of a linear scan over the student and room vectors.
+ *
+ * Key Features:
+ * - Student key -> slot and room key -> slot maps
+ * - Full rebuild after load/sort
+ * - Incremental maintenance on add/remove/update
+ * - Free-capacity buckets for O(1) "room with >= N free slots" queries
+ * - A columnar mirror of the rooms (RoomTable) for aggregate scans
+ * - Live report counters (HostelStats) kept current by the same hooks
+ * - Name/email/course search (SearchIndex), built on first use
+ * - Immutable record versions for lock-free readers (DataVersions), kept
+ *   from the first publishVersion() on
+ *
+ * The index does not own the records; callers must notify it whenever
+ * they insert, erase, re-key or change an element of the vectors it
+ * describes.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef HOSTELINDEX_H
+#define HOSTELINDEX_H
+
+#include "Student.h"
+#include "Room.h"
+#include "RoomTable.h"
+#include "HostelStats.h"
+#include "SearchIndex.h"
+#include "RoomReservations.h"
+#include "DataVersions.h"
+#include <memory>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using namespace std;
+
+class HostelIndex {
+private:
+    StudentSlots studentSlots;
+    unordered_map<RoomKey, size_t> roomSlots;
+    
+    // Availability buckets: freeBuckets[n] holds the slots of rooms with
+    // exactly n free places; bucketOf/bucketPos locate a room inside them
+    vector<vector<size_t>> freeBuckets;
+    vector<int> bucketOf;
+    vector<size_t> bucketPos;
+    
+    RoomTable table; // hot room fields, one row per room slot
+    HostelStats stats;
+    SearchIndex search;
+    RoomReservations reservations; // beds claimed per room, for concurrent allocators
+    DataVersions versions;
+    
+    void bucketInsert(size_t slot, int freeSlots);
+    void bucketRemove(size_t slot);
+    void bucketRefresh(const vector<Room>& rooms, size_t slot);
+    void rebuildBuckets(const vector<Room>& rooms);
+
+public:
+    // Full rebuilds (after load or reordering)
+    void rebuild(const vector<Student>& students, const vector<Room>& rooms);
+    void rebuildStudents(const vector<Student>& students);
+    void rebuildRooms(const vector<Room>& rooms);
+    // Links the room table's occupants to student slots; rebuildRooms()
+    // leaves this out so rooms and students can be loaded concurrently
+    void resolveOccupants(const vector<Room>& rooms);
+
+    // Lookups by key; user input goes through Keys::findStudent/findRoom
+    Student* findStudent(vector<Student>& students, StudentKey studentId) const;
+    Room* findRoom(vector<Room>& rooms, RoomKey roomNumber) const;
+    bool hasStudent(StudentKey studentId) const;
+    bool hasRoom(RoomKey roomNumber) const;
+    size_t studentSlot(StudentKey studentId) const;
+    size_t roomSlot(RoomKey roomNumber) const;
+
+    // Incremental maintenance
+    void studentAppended(const vector<Student>& students);
+    void studentErased(const vector<Student>& students, size_t slot, StudentKey studentId);
+    void studentRekeyed(StudentKey oldId, StudentKey newId);
+    void studentChanged(const vector<Student>& students, size_t slot);
+    void roomAppended(const vector<Room>& rooms);
+    void roomErased(const vector<Room>& rooms, size_t slot, RoomKey roomNumber);
+    void roomRekeyed(RoomKey oldNumber, RoomKey newNumber);
+    void roomChanged(const vector<Room>& rooms, size_t slot);
+    
+    // Occupancy changes routed through the index so the buckets stay current;
+    // addOccupant() is reserveBed() followed by commitOccupant()
+    bool addOccupant(vector<Room>& rooms, size_t slot, StudentKey studentId);
+    bool removeOccupant(vector<Room>& rooms, size_t slot, StudentKey studentId);
+    
+    // Bed reservations: reserveBed() claims a free bed with a single CAS and
+    // may run on many threads at once (e.g. under the server's shared lock).
+    // The claim then becomes an occupant through commitOccupant(), which
+    // updates shared structures and so must be serialised, or is handed
+    // back with cancelReservation()
+    bool reserveBed(size_t slot);
+    void cancelReservation(size_t slot);
+    bool commitOccupant(vector<Room>& rooms, size_t slot, StudentKey studentId);
+    // Occupants plus reservations not yet committed
+    int32_t claimedBeds(size_t slot) const;
+    
+    // Capacity, occupant lists, student room links and bed claims checked
+    // against each other; claims above the occupancy only count as drift
+    // when no reservation can be in flight
+    vector<string> checkOccupancy(const vector<Student>& students, const vector<Room>& rooms,
+                                  bool reservationsIdle) const;
+    
+    // Availability queries
+    size_t findRoomWithSlots(int minFreeSlots) const;
+    size_t countRoomsWithSlots(int minFreeSlots) const;
+    
+    // Columnar view of the rooms for scans
+    const RoomTable& roomTable() const;
+    // Counters behind the summary reports
+    const HostelStats& liveStats() const;
+    // Student search; the first call builds the search index
+    SearchIndex::Page searchStudents(const vector<Student>& students, string_view query,
+                                     unsigned fields, SearchIndex::Mode mode,
+                                     size_t offset, size_t limit);
+    // Builds the search index if it is not current, so that concurrent
+    // readers can use studentSearch() without writing to it
+    void prepareSearch(const vector<Student>& students);
+    const SearchIndex& studentSearch() const;
+    
+    // Record versions: publishVersion() makes the current records and live
+    // counters the version readers get from pinVersion(), copying only what
+    // changed since the last call. It must be serialised with every write;
+    // pinVersion() may run on any thread and returns null before the first
+    // publish
+    void publishVersion(const vector<Student>& students, const vector<Room>& rooms);
+    shared_ptr<const DataVersion> pinVersion() const;
+
+    static const size_t npos = static_cast<size_t>(-1);
+};
+
+#endif // HOSTELINDEX_H
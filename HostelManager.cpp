@@ -1,114 +1,239 @@
 #include "HostelManager.h"
+#include "HostelServer.h"
+#include "ReshuffleEngine.h"
+#include "CsvReader.h"
+#include "CsvUtils.h"
+#include "Snapshot.h"
+#include "Validation.h"
+#include "BlockAllocator.h"
 #include <iostream>
 #include <limits>
 #include <cstdlib>
-#include <unordered_set>
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <filesystem>
 
 using namespace std;
 
+namespace {
+    // Students listed per page of search results
+    const size_t SEARCH_PAGE_SIZE = 20;
+    // Occupancy problems listed by check before the rest are counted
+    const size_t MAX_DRIFT_LINES = 20;
+    // Invalid student rows listed after a CSV load before the rest are counted
+    const size_t MAX_INVALID_LINES = 20;
+
+    // CSVs are saved to path.tmp and then renamed over path, so a save that
+    // fails or is interrupted leaves the previous file intact
+    template <typename Record>
+    bool writeSideFile(const string& path, const vector<Record>& records) {
+        ofstream file(path + ".tmp", ios::trunc);
+        if (!file.is_open()) return false;
+        for (const auto& record : records) {
+            record.saveToFile(file);
+        }
+        file.flush();
+        return static_cast<bool>(file);
+    }
+
+    bool replaceWithSideFile(const string& path) {
+        error_code ec;
+        filesystem::rename(path + ".tmp", path, ec);
+        return !ec;
+    }
+
+    void discardSideFile(const string& path) {
+        error_code ec;
+        filesystem::remove(path + ".tmp", ec);
+    }
+
+    template <typename Record>
+    bool replaceFile(const string& path, const vector<Record>& records) {
+        if (writeSideFile(path, records) && replaceWithSideFile(path)) return true;
+        discardSideFile(path);
+        return false;
+    }
+}
+
+bool HostelManager::arenaLoading = true;
+
 // Constructor
 HostelManager::HostelManager() : currentAdmin(nullptr), 
                                  studentsFile("students.csv"), 
                                  roomsFile("rooms.csv"), 
-                                 adminsFile("admins.csv") {
+                                 adminsFile("admins.csv"),
+                                 journalFile("hostel.journal"),
+                                 snapshotFile("hostel.snap"),
+                                 compactThreshold(1000),
+                                 loadThreads(0) {
+    arena.setEnabled(arenaLoading);
+    loadData();
+}
+
+// Constructor for explicit data files; the journal and snapshot live next
+// to the students file
+HostelManager::HostelManager(const string& studentsPath, const string& roomsPath,
+                             const string& adminsPath)
+    : currentAdmin(nullptr),
+      studentsFile(studentsPath),
+      roomsFile(roomsPath),
+      adminsFile(adminsPath),
+      journalFile((filesystem::path(studentsPath).parent_path() / "hostel.journal").string()),
+      snapshotFile((filesystem::path(studentsPath).parent_path() / "hostel.snap").string()),
+      compactThreshold(1000),
+      loadThreads(0) {
+    arena.setEnabled(arenaLoading);
     loadData();
 }
 
 // File Operations
 void HostelManager::loadData() {
     try {
-        loadAdmins();
-        loadStudents();
-        loadRooms();
+        // Records from an earlier load go first, then their memory in one step
+        students.clear();
+        rooms.clear();
+        arena.release();
+
+        // A snapshot taken from exactly these CSVs skips text parsing entirely
+        if (!loadSnapshot()) {
+            // The three files share no state until the journal is replayed,
+            // so they load concurrently
+            future<void> adminsLoaded = async(launch::async, &HostelManager::loadAdmins, this);
+            future<void> roomsLoaded = async(launch::async, &HostelManager::loadRooms, this);
+            loadStudents();
+            roomsLoaded.get();
+            adminsLoaded.get();
+            index.resolveOccupants(rooms);
+            reportInvalidStudents();
+        }
+        replayJournal();
         cout << "Data loaded successfully!" << endl;
     } catch (const exception& e) {
         cout << "Error loading data: " << e.what() << endl;
     }
 }
 
+// Rows breaking the input rules are kept, since the file is the record,
+// but listed so that a hand-edited CSV does not go unnoticed. Snapshot
+// loads skip this: a snapshot holds data that was checked on its way in
+void HostelManager::reportInvalidStudents() const {
+    vector<uint8_t> errors = Validation::validateAll(students);
+    size_t invalid = 0;
+    for (size_t i = 0; i < errors.size(); ++i) {
+        if (errors[i] == Validation::OK) continue;
+        if (invalid++ < MAX_INVALID_LINES) {
+            cout << "Warning: student " << students[i].getStudentId() << " in " << studentsFile << ": "
+                 << Validation::describe(errors[i]) << endl;
+        }
+    }
+    if (invalid > MAX_INVALID_LINES) {
+        cout << "Warning: " << invalid - MAX_INVALID_LINES << " more students with invalid fields" << endl;
+    }
+}
+
+// Worker threads for parsing a file of the given size; small files are
+// cheaper to parse on one thread than to split
+size_t HostelManager::loadThreadsFor(size_t bytes) const {
+    const size_t minChunkBytes = 1 << 20;
+    size_t threads = loadThreads;
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    return max<size_t>(1, min(threads, bytes / minChunkBytes));
+}
+
+void HostelManager::setLoadThreads(size_t threads) {
+    loadThreads = threads;
+}
+
+// Only affects managers constructed afterwards
+void HostelManager::setArenaLoading(bool enabled) {
+    arenaLoading = enabled;
+}
+
 void HostelManager::saveData() {
     try {
-        saveAdmins();
-        saveStudents();
-        saveRooms();
-        cout << "Data saved successfully!" << endl;
+        bool adminsSaved = saveAdmins();
+        if (compactData(cout) && adminsSaved) {
+            cout << "Data saved successfully!" << endl;
+        }
     } catch (const exception& e) {
         cout << "Error saving data: " << e.what() << endl;
     }
 }
 
 void HostelManager::loadStudents() {
-    ifstream file(studentsFile);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.open(studentsFile)) {
         // File doesn't exist, create empty file
         ofstream newFile(studentsFile);
         newFile.close();
         return;
     }
     
+    // Chunks are parsed in parallel and merged back in file order
+    // Each parser thread fills its records from its own arena region
+    vector<vector<Student>> parts = csvParseParallel<Student>(file.view(), loadThreadsFor(file.size()),
+        [this]() { return Student(arena.region()); });
+    size_t total = 0;
+    for (const auto& part : parts) total += part.size();
+    
     students.clear();
-    Student student;
-    unordered_set<string> seenIds;
-    while (student.loadFromFile(file)) {
-        if (!student.getStudentId().empty()) {
-            if (seenIds.insert(student.getStudentId()).second) {
-                students.push_back(student);
-            } else {
-                // Duplicate ID encountered in file; skip it
-            }
+    index.rebuildStudents(students);
+    students.reserve(total);
+    for (auto& part : parts) {
+        for (auto& student : part) {
+            if (student.getKey() == Keys::NONE) continue;
+            // Duplicate ID encountered in file; the first occurrence wins
+            if (index.hasStudent(student.getKey())) continue;
+            students.push_back(move(student));
+            index.studentAppended(students);
         }
     }
-    file.close();
 }
 
-void HostelManager::saveStudents() {
-    ofstream file(studentsFile);
-    if (!file.is_open()) {
-        handleFileError("save", studentsFile);
-        return;
+bool HostelManager::saveStudents() {
+    if (!replaceFile(studentsFile, students)) {
+        handleFileError("save", studentsFile, cout);
+        return false;
     }
-    
-    for (const auto& student : students) {
-        student.saveToFile(file);
-    }
-    file.close();
+    return true;
 }
 
 void HostelManager::loadRooms() {
-    ifstream file(roomsFile);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.open(roomsFile)) {
         // File doesn't exist, create empty file
         ofstream newFile(roomsFile);
         newFile.close();
         return;
     }
     
+    vector<vector<Room>> parts = csvParseParallel<Room>(file.view(), loadThreadsFor(file.size()),
+        [this]() { return Room(arena.region()); });
+    size_t total = 0;
+    for (const auto& part : parts) total += part.size();
+    
     rooms.clear();
-    Room room;
-    while (room.loadFromFile(file)) {
-        if (!room.getRoomNumber().empty()) {
-            rooms.push_back(room);
+    rooms.reserve(total);
+    for (auto& part : parts) {
+        for (auto& room : part) {
+            if (room.getKey() != Keys::NONE) rooms.push_back(move(room));
         }
     }
-    file.close();
+    index.rebuildRooms(rooms);
 }
 
-void HostelManager::saveRooms() {
-    ofstream file(roomsFile);
-    if (!file.is_open()) {
-        handleFileError("save", roomsFile);
-        return;
-    }
-    
-    for (const auto& room : rooms) {
-        room.saveToFile(file);
+bool HostelManager::saveRooms() {
+    if (!replaceFile(roomsFile, rooms)) {
+        handleFileError("save", roomsFile, cout);
+        return false;
     }
-    file.close();
+    return true;
 }
 
 void HostelManager::loadAdmins() {
-    ifstream file(adminsFile);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.open(adminsFile)) {
         // Create default admin if file doesn't exist
         Admin defaultAdmin("ADM001", "admin", "admin123", "System Administrator", "admin@hostel.com");
         admins.push_back(defaultAdmin);
@@ -117,26 +242,190 @@ void HostelManager::loadAdmins() {
     }
     
     admins.clear();
+    CsvCursor cursor(file.view());
+    vector<string_view> fields;
     Admin admin;
-    while (admin.loadFromFile(file)) {
-        if (!admin.getAdminId().empty()) {
+    while (cursor.next(fields)) {
+        if (admin.loadFromFields(fields) && !admin.getAdminId().empty()) {
             admins.push_back(admin);
         }
     }
-    file.close();
 }
 
-void HostelManager::saveAdmins() {
-    ofstream file(adminsFile);
-    if (!file.is_open()) {
-        handleFileError("save", adminsFile);
-        return;
+bool HostelManager::saveAdmins() {
+    if (!replaceFile(adminsFile, admins)) {
+        handleFileError("save", adminsFile, cout);
+        return false;
     }
-    
-    for (const auto& admin : admins) {
-        admin.saveToFile(file);
+    return true;
+}
+
+// Fold the journal into the CSV snapshots and start a fresh journal. The
+// journal is the only durable copy of its records until both CSVs are
+// safely replaced, so it is kept if either save fails
+bool HostelManager::compactData(ostream& out) {
+    // Both CSVs are written out before either is replaced, so a failed write
+    // leaves the pair on disk as it was
+    string failed;
+    if (!writeSideFile(studentsFile, students)) failed = studentsFile;
+    else if (!writeSideFile(roomsFile, rooms)) failed = roomsFile;
+    else if (!replaceWithSideFile(studentsFile)) failed = studentsFile;
+    else if (!replaceWithSideFile(roomsFile)) failed = roomsFile;
+    if (!failed.empty()) {
+        discardSideFile(studentsFile);
+        discardSideFile(roomsFile);
+        handleFileError("save", failed, out);
+        return false;
+    }
+    if (!saveSnapshot()) {
+        handleFileError("save", snapshotFile, out);
     }
-    file.close();
+    if (!journal.truncate()) {
+        handleFileError("truncate", journalFile, out);
+    }
+    return true;
+}
+
+// Binary snapshot, stamped with the CSVs it mirrors so that editing a CSV
+// by hand invalidates it
+bool HostelManager::saveSnapshot() {
+    Snapshot::SourceStamp stamp = Snapshot::stampFiles(studentsFile, roomsFile, adminsFile);
+    return Snapshot::save(snapshotFile, students, rooms, admins, stamp);
+}
+
+bool HostelManager::loadSnapshot() {
+    Snapshot::SourceStamp stamp = Snapshot::stampFiles(studentsFile, roomsFile, adminsFile);
+    if (!Snapshot::load(snapshotFile, stamp, students, rooms, admins, arena.region())) return false;
+    index.rebuild(students, rooms);
+    return true;
+}
+
+// Journal Operations
+void HostelManager::replayJournal() {
+    size_t replayed = journal.replay(journalFile, [this](const string& op, const string& key,
+                                     const vector<string>& payload) {
+        applyJournalRecord(op, key, payload);
+    });
+    if (!journal.open(journalFile)) {
+        handleFileError("open", journalFile, cout);
+    }
+    if (replayed > 0) {
+        cout << "Replayed " << replayed << " journal record(s)." << endl;
+    }
+}
+
+// Records set state rather than apply deltas, so replaying a record that is
+// already reflected in the CSVs (crash during compaction) is harmless
+void HostelManager::applyJournalRecord(const string& op, const string& key,
+                                       const vector<string>& payload) {
+    if (op == "A" && !payload.empty()) {
+        StudentKey studentId = Keys::findStudent(key);
+        RoomKey roomNumber = Keys::findRoom(payload[0]);
+        Student* student = index.findStudent(students, studentId);
+        size_t roomSlot = index.roomSlot(roomNumber);
+        if (!student || roomSlot == HostelIndex::npos) return;
+        if (student->getIsAllocated() && student->getRoomKey() != roomNumber) {
+            size_t oldSlot = index.roomSlot(student->getRoomKey());
+            if (oldSlot != HostelIndex::npos) index.removeOccupant(rooms, oldSlot, studentId);
+        }
+        const auto& occupants = rooms[roomSlot].getOccupantKeys();
+        bool present = find(occupants.begin(), occupants.end(), studentId) != occupants.end();
+        if (present || index.addOccupant(rooms, roomSlot, studentId)) {
+            student->setRoomKey(roomNumber);
+            index.studentChanged(students, index.studentSlot(studentId));
+        }
+    } else if (op == "D") {
+        StudentKey studentId = Keys::findStudent(key);
+        Student* student = index.findStudent(students, studentId);
+        if (!student || !student->getIsAllocated()) return;
+        size_t roomSlot = index.roomSlot(student->getRoomKey());
+        if (roomSlot != HostelIndex::npos) index.removeOccupant(rooms, roomSlot, studentId);
+        student->setRoomKey(Keys::NONE);
+        index.studentChanged(students, index.studentSlot(studentId));
+    } else if (op == "S") {
+        Student student;
+        if (!student.loadFromTokens(payload) || student.getKey() == Keys::NONE) return;
+        size_t slot = index.studentSlot(Keys::findStudent(key));
+        if (slot == HostelIndex::npos) slot = index.studentSlot(student.getKey());
+        if (slot == HostelIndex::npos) {
+            students.push_back(student);
+            index.studentAppended(students);
+        } else {
+            StudentKey oldId = students[slot].getKey();
+            if (oldId != student.getKey() && index.hasStudent(student.getKey())) return;
+            students[slot] = student;
+            index.studentRekeyed(oldId, student.getKey());
+            index.studentChanged(students, slot);
+        }
+    } else if (op == "XS") {
+        StudentKey studentId = Keys::findStudent(key);
+        size_t slot = index.studentSlot(studentId);
+        if (slot == HostelIndex::npos) return;
+        students.erase(students.begin() + slot);
+        index.studentErased(students, slot, studentId);
+    } else if (op == "R") {
+        Room room;
+        if (!room.loadFromTokens(payload) || room.getKey() == Keys::NONE) return;
+        size_t slot = index.roomSlot(Keys::findRoom(key));
+        if (slot == HostelIndex::npos) slot = index.roomSlot(room.getKey());
+        if (slot == HostelIndex::npos) {
+            rooms.push_back(room);
+            index.roomAppended(rooms);
+        } else {
+            RoomKey oldNumber = rooms[slot].getKey();
+            if (oldNumber != room.getKey() && index.hasRoom(room.getKey())) return;
+            rooms[slot] = room;
+            index.roomRekeyed(oldNumber, room.getKey());
+            index.roomChanged(rooms, slot);
+        }
+    } else if (op == "XR") {
+        RoomKey roomNumber = Keys::findRoom(key);
+        size_t slot = index.roomSlot(roomNumber);
+        if (slot == HostelIndex::npos) return;
+        rooms.erase(rooms.begin() + slot);
+        index.roomErased(rooms, slot, roomNumber);
+    } else if (op == "T") {
+        // Split into steps first; a torn record is dropped whole
+        vector<vector<string>> steps;
+        size_t field = 0;
+        while (field < payload.size()) {
+            size_t width = (payload[field] == "A") ? 3 : (payload[field] == "D") ? 2 : 0;
+            if (width == 0 || field + width > payload.size()) return;
+            steps.emplace_back(payload.begin() + field, payload.begin() + field + width);
+            field += width;
+        }
+        if (to_string(steps.size()) != key) return;
+        for (const auto& step : steps) {
+            applyJournalRecord(step[0], step[1], vector<string>(step.begin() + 2, step.end()));
+        }
+    }
+}
+
+// Transactions
+AllocationTransaction HostelManager::beginTransaction() {
+    return AllocationTransaction(students, rooms, index);
+}
+
+bool HostelManager::commitTransaction(AllocationTransaction& transaction) {
+    if (!transaction.commit()) return false;
+    const auto& committed = transaction.committedSteps();
+    if (committed.empty()) return true;
+    vector<pair<string, string>> steps;
+    steps.reserve(committed.size());
+    for (const auto& step : committed) {
+        steps.emplace_back(Keys::studentId(step.studentId),
+                           step.roomNumber == Keys::NONE ? string() : Keys::roomNumber(step.roomNumber));
+    }
+    return afterJournalWrite(journal.logTransaction(steps), cout);
+}
+
+// A failed append (or an overlong journal) falls back to a full rewrite;
+// false means the change is in memory only. A journalled change is saved
+// even if the size-triggered rewrite fails, as the journal is then kept
+bool HostelManager::afterJournalWrite(bool logged, ostream& out) {
+    if (!logged) return compactData(out);
+    if (journal.size() >= compactThreshold) compactData(out);
+    return true;
 }
 
 // Authentication
@@ -179,8 +468,9 @@ void HostelManager::addStudent() {
         return;
     }
     
-    currentAdmin->addStudent(students);
-    saveStudents();
+    if (currentAdmin->addStudent(students, index)) {
+        afterJournalWrite(journal.logStudent(students.back().getStudentId(), students.back()), cout);
+    }
 }
 
 void HostelManager::removeStudent() {
@@ -193,8 +483,9 @@ void HostelManager::removeStudent() {
     cout << "Enter Student ID to remove: ";
     getline(cin, studentId);
     
-    currentAdmin->removeStudent(students, studentId);
-    saveStudents();
+    if (currentAdmin->removeStudent(students, index, studentId)) {
+        afterJournalWrite(journal.logRemoveStudent(studentId), cout);
+    }
 }
 
 void HostelManager::updateStudent() {
@@ -207,8 +498,10 @@ void HostelManager::updateStudent() {
     cout << "Enter Student ID to update: ";
     getline(cin, studentId);
     
-    currentAdmin->updateStudent(students, studentId);
-    saveStudents();
+    size_t slot = index.studentSlot(Keys::findStudent(studentId));
+    if (currentAdmin->updateStudent(students, index, studentId)) {
+        afterJournalWrite(journal.logStudent(studentId, students[slot]), cout);
+    }
 }
 
 void HostelManager::displayAllStudents() {
@@ -221,15 +514,49 @@ void HostelManager::displayAllStudents() {
 }
 
 void HostelManager::searchStudent() {
-    string studentId;
-    cout << "Enter Student ID to search: ";
-    getline(cin, studentId);
+    string query;
+    cout << "Enter Student ID, or part of a name, email or course: ";
+    getline(cin, query);
     
-    Student* student = currentAdmin->findStudent(students, studentId);
+    Student* student = index.findStudent(students, Keys::findStudent(query));
     if (student) {
-        student->displayInfo();
-    } else {
+        student->displayInfo(cout);
+        return;
+    }
+    
+    // Word prefixes first ("sha" finds "Pari Shah"), any substring if none match
+    SearchIndex::Mode mode = SearchIndex::PREFIX;
+    SearchIndex::Page page = index.searchStudents(students, query, SearchIndex::ALL_FIELDS, mode,
+                                                  0, SEARCH_PAGE_SIZE);
+    if (page.total == 0) {
+        mode = SearchIndex::CONTAINS;
+        page = index.searchStudents(students, query, SearchIndex::ALL_FIELDS, mode, 0, SEARCH_PAGE_SIZE);
+    }
+    if (page.total == 0) {
         cout << "Student not found!" << endl;
+        return;
+    }
+    if (page.total == 1) {
+        students[page.slots.front()].displayInfo(cout);
+        return;
+    }
+    
+    size_t offset = 0;
+    while (true) {
+        cout << "\n=== Search Results " << offset + 1 << "-" << offset + page.slots.size()
+             << " of " << page.total << " ===" << endl;
+        Admin::displayStudents(students, page.slots, cout);
+        
+        bool more = offset + page.slots.size() < page.total;
+        if (!more && offset == 0) return;
+        cout << (more ? "n = next page, " : "") << (offset > 0 ? "p = previous page, " : "")
+             << "Enter = done: ";
+        string choice;
+        getline(cin, choice);
+        if (choice == "n" && more) offset += SEARCH_PAGE_SIZE;
+        else if (choice == "p" && offset > 0) offset -= SEARCH_PAGE_SIZE;
+        else return;
+        page = index.searchStudents(students, query, SearchIndex::ALL_FIELDS, mode, offset, SEARCH_PAGE_SIZE);
     }
 }
 
@@ -237,6 +564,22 @@ void HostelManager::displayStudentDetails() {
     searchStudent();
 }
 
+void HostelManager::bulkImportStudents() {
+    if (!isAdminLoggedIn()) {
+        cout << "Please login as admin first!" << endl;
+        return;
+    }
+    
+    string path;
+    cout << "Enter CSV file to import: ";
+    getline(cin, path);
+    if (path.empty()) {
+        handleInputError("No file given.");
+        return;
+    }
+    importStudents(path, path + ".rejects.csv");
+}
+
 // Room Operations
 void HostelManager::addRoom() {
     if (!isAdminLoggedIn()) {
@@ -244,8 +587,9 @@ void HostelManager::addRoom() {
         return;
     }
     
-    currentAdmin->addRoom(rooms);
-    saveRooms();
+    if (currentAdmin->addRoom(rooms, index)) {
+        afterJournalWrite(journal.logRoom(rooms.back().getRoomNumber(), rooms.back()), cout);
+    }
 }
 
 void HostelManager::removeRoom() {
@@ -258,8 +602,9 @@ void HostelManager::removeRoom() {
     cout << "Enter Room Number to remove: ";
     getline(cin, roomNumber);
     
-    currentAdmin->removeRoom(rooms, roomNumber);
-    saveRooms();
+    if (currentAdmin->removeRoom(rooms, index, roomNumber)) {
+        afterJournalWrite(journal.logRemoveRoom(roomNumber), cout);
+    }
 }
 
 void HostelManager::updateRoom() {
@@ -272,8 +617,10 @@ void HostelManager::updateRoom() {
     cout << "Enter Room Number to update: ";
     getline(cin, roomNumber);
     
-    currentAdmin->updateRoom(rooms, roomNumber);
-    saveRooms();
+    size_t slot = index.roomSlot(Keys::findRoom(roomNumber));
+    if (currentAdmin->updateRoom(rooms, index, roomNumber)) {
+        afterJournalWrite(journal.logRoom(roomNumber, rooms[slot]), cout);
+    }
 }
 
 void HostelManager::displayAllRooms() {
@@ -290,9 +637,9 @@ void HostelManager::searchRoom() {
     cout << "Enter Room Number to search: ";
     getline(cin, roomNumber);
     
-    Room* room = currentAdmin->findRoom(rooms, roomNumber);
+    Room* room = index.findRoom(rooms, Keys::findRoom(roomNumber));
     if (room) {
-        room->displayInfo();
+        room->displayInfo(cout);
     } else {
         cout << "Room not found!" << endl;
     }
@@ -315,9 +662,9 @@ void HostelManager::allocateRoom() {
     cout << "Enter Room Number: ";
     getline(cin, roomNumber);
     
-    if (currentAdmin->allocateRoom(students, rooms, studentId, roomNumber)) {
-        saveStudents();
-        saveRooms();
+    if (currentAdmin->allocateRoom(students, rooms, index, Keys::findStudent(studentId),
+                                   Keys::findRoom(roomNumber), cout)) {
+        afterJournalWrite(journal.logAllocate(studentId, roomNumber), cout);
     }
 }
 
@@ -331,9 +678,8 @@ void HostelManager::deallocateRoom() {
     cout << "Enter Student ID: ";
     getline(cin, studentId);
     
-    if (currentAdmin->deallocateRoom(students, rooms, studentId)) {
-        saveStudents();
-        saveRooms();
+    if (currentAdmin->deallocateRoom(students, rooms, index, Keys::findStudent(studentId), cout)) {
+        afterJournalWrite(journal.logDeallocate(studentId), cout);
     }
 }
 
@@ -343,9 +689,9 @@ void HostelManager::autoAllocateRooms() {
         return;
     }
     
-    currentAdmin->autoAllocateRooms(students, rooms);
-    saveStudents();
-    saveRooms();
+    currentAdmin->autoAllocateRooms(students, rooms, index);
+    // Bulk pass touches most records; one full snapshot beats a journal entry each
+    compactData(cout);
 }
 
 void HostelManager::allocateWithRoommatePreference() {
@@ -354,9 +700,51 @@ void HostelManager::allocateWithRoommatePreference() {
         return;
     }
     
-    currentAdmin->allocateWithRoommatePreference(students, rooms);
-    saveStudents();
-    saveRooms();
+    currentAdmin->allocateWithRoommatePreference(students, rooms, index);
+    compactData(cout);
+}
+
+void HostelManager::allocateOptimal() {
+    if (!isAdminLoggedIn()) {
+        cout << "Please login as admin first!" << endl;
+        return;
+    }
+    
+    currentAdmin->allocateOptimal(students, rooms, index);
+    compactData(cout);
+}
+
+void HostelManager::allocateByBlock() {
+    if (!isAdminLoggedIn()) {
+        cout << "Please login as admin first!" << endl;
+        return;
+    }
+    
+    // The same seed and data always give the same allocation
+    string input;
+    cout << "Enter seed (press Enter for " << BlockAllocator::DEFAULT_SEED << "): ";
+    getline(cin, input);
+    uint32_t seed;
+    if (!parseSeed(input, seed)) return;
+    
+    currentAdmin->allocateByBlock(students, rooms, index, seed);
+    compactData(cout);
+}
+
+void HostelManager::reshuffleRooms() {
+    if (!isAdminLoggedIn()) {
+        cout << "Please login as admin first!" << endl;
+        return;
+    }
+    
+    string path;
+    cout << "Enter CSV file of moves and swaps: ";
+    getline(cin, path);
+    if (path.empty()) {
+        handleInputError("No file given.");
+        return;
+    }
+    reshuffle(path);
 }
 
 // Report Operations
@@ -366,7 +754,7 @@ void HostelManager::generateAllocationReport() {
         return;
     }
     
-    currentAdmin->generateAllocationReport(students, rooms);
+    currentAdmin->generateAllocationReport(index.liveStats().summary(index.roomTable()), cout);
 }
 
 void HostelManager::generateOccupancyReport() {
@@ -375,7 +763,7 @@ void HostelManager::generateOccupancyReport() {
         return;
     }
     
-    currentAdmin->generateOccupancyReport(rooms);
+    currentAdmin->generateOccupancyReport(index.liveStats().summary(index.roomTable()), cout);
 }
 
 void HostelManager::generateStudentReport() {
@@ -384,7 +772,280 @@ void HostelManager::generateStudentReport() {
         return;
     }
     
-    currentAdmin->generateStudentReport(students);
+    currentAdmin->generateStudentReport(index.liveStats().summary(index.roomTable()), cout);
+}
+
+void HostelManager::generateBreakdownReport() {
+    if (!isAdminLoggedIn()) {
+        cout << "Please login as admin first!" << endl;
+        return;
+    }
+    
+    currentAdmin->generateBreakdownReport(ReportEngine::compute(students, index.roomTable(), 0), cout);
+}
+
+// Batch Operations (non-interactive; each persists once at the end)
+Admin& HostelManager::batchAdmin() {
+    // Batch runs act as the first admin account
+    if (admins.empty()) {
+        admins.push_back(Admin("ADM001", "admin", "admin123", "System Administrator", "admin@hostel.com"));
+        saveAdmins();
+    }
+    return admins.front();
+}
+
+bool HostelManager::runAllocation(const string& strategy, const string& seed) {
+    Admin& admin = batchAdmin();
+    uint32_t blockSeed;
+    if (strategy == "block") {
+        if (!parseSeed(seed, blockSeed)) return false;
+        admin.allocateByBlock(students, rooms, index, blockSeed);
+    } else if (strategy == "auto") {
+        admin.autoAllocateRooms(students, rooms, index);
+    } else if (strategy == "roommate") {
+        admin.allocateWithRoommatePreference(students, rooms, index);
+    } else if (strategy == "optimal") {
+        admin.allocateOptimal(students, rooms, index);
+    } else {
+        handleInputError("Unknown allocation strategy: " + strategy);
+        return false;
+    }
+    // The run is only done once it is on disk
+    return compactData(cout);
+}
+
+bool HostelManager::deallocateStudents(const vector<string>& studentIds) {
+    vector<StudentKey> keys;
+    keys.reserve(studentIds.size());
+    for (const auto& studentId : studentIds) keys.push_back(Keys::findStudent(studentId));
+    return deallocateKeys(keys);
+}
+
+bool HostelManager::deallocateAll() {
+    vector<StudentKey> allocated;
+    for (const auto& student : students) {
+        if (student.getIsAllocated()) allocated.push_back(student.getKey());
+    }
+    return deallocateKeys(allocated);
+}
+
+bool HostelManager::deallocateKeys(const vector<StudentKey>& studentIds) {
+    Admin& admin = batchAdmin();
+    int released = 0;
+    for (StudentKey studentId : studentIds) {
+        if (admin.deallocateRoom(students, rooms, index, studentId, cout)) released++;
+    }
+    bool saved = compactData(cout);
+    cout << released << " of " << studentIds.size() << " students deallocated." << endl;
+    return saved && released == static_cast<int>(studentIds.size());
+}
+
+// The whole file is one transaction: checked as a batch, then applied and
+// journalled once, or not at all
+bool HostelManager::reshuffle(const string& path) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        handleFileError("open", path, cout);
+        return false;
+    }
+    
+    vector<ReshuffleEngine::Request> requests;
+    AllocationTransaction transaction = beginTransaction();
+    size_t moved = 0;
+    if (!ReshuffleEngine::parse(file, requests) ||
+        !ReshuffleEngine::stage(requests, students, index, transaction, moved)) {
+        cout << "Reshuffle cancelled; no student was moved." << endl;
+        return false;
+    }
+    if (!commitTransaction(transaction)) {
+        // Committed steps are left behind only when the save failed
+        if (transaction.committedSteps().empty()) {
+            cout << "Reshuffle cancelled; no student was moved." << endl;
+        } else {
+            cout << "Reshuffle applied but not saved; " << moved << " students moved in memory only." << endl;
+        }
+        return false;
+    }
+    cout << requests.size() << " requests applied; " << moved << " students changed rooms." << endl;
+    return true;
+}
+
+bool HostelManager::importStudents(const string& path, const string& rejectsPath) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        handleFileError("open", path, cout);
+        return false;
+    }
+    
+    // Rows are read, checked and appended one at a time, so memory grows
+    // only with the accepted records, never with the size of the file
+    ofstream rejects; // created on the first rejected row
+    bool rejectsFailed = false;
+    size_t firstNew = students.size();
+    size_t record = 0, added = 0, duplicates = 0, invalid = 0;
+    string line;
+    auto reject = [&](const string& reason) {
+        if (!rejects.is_open() && !rejectsFailed) {
+            rejects.open(rejectsPath);
+            rejectsFailed = !rejects.is_open();
+            if (rejectsFailed) handleFileError("create", rejectsPath, cout);
+        }
+        // Record number and reason, then the row exactly as it was read
+        if (rejects.is_open()) rejects << record << ',' << csvEscape(reason) << ',' << line << '\n';
+    };
+    
+    while (csvReadRecord(file, line)) {
+        ++record;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (csvTrim(line).empty()) continue;
+        
+        Student student;
+        if (!student.loadFromTokens(csvParseLine(line))) {
+            invalid++;
+            reject("malformed record");
+            continue;
+        }
+        // Same field rules as interactive input
+        uint8_t errors = Validation::validate(student);
+        if (errors != Validation::OK) {
+            invalid++;
+            reject(Validation::describe(errors));
+            continue;
+        }
+        // Same rule as loading: existing IDs win, and so does the first
+        // row of an ID repeated within the file
+        size_t slot = index.studentSlot(student.getKey());
+        if (slot != HostelIndex::npos) {
+            duplicates++;
+            reject(slot >= firstNew ? "duplicate ID in file" : "ID already registered");
+            continue;
+        }
+        // New admissions start unallocated; beds come from an allocation run
+        student.setRoomKey(Keys::NONE);
+        students.push_back(move(student));
+        index.studentAppended(students);
+        added++;
+    }
+    
+    bool readFailed = file.bad();
+    if (readFailed) handleFileError("read", path, cout);
+    
+    // One save for the whole batch
+    bool saved = (added == 0) || compactData(cout);
+    cout << "Imported " << added << " of " << record << " records (" << duplicates
+         << " duplicate, " << invalid << " invalid)." << endl;
+    if (rejects.is_open()) {
+        cout << "Rejected rows written to " << rejectsPath << endl;
+    }
+    // Some rejected rows are expected in a bulk file, but a file with
+    // nothing usable in it, or one read or saved only in part, is a failure
+    bool nothingUsable = added == 0 && duplicates + invalid > 0;
+    return saved && !readFailed && !rejectsFailed && !nothingUsable;
+}
+
+bool HostelManager::printReports(const string& type) {
+    return writeReports(batchAdmin(), type, nullptr, cout);
+}
+
+bool HostelManager::checkStats() {
+    return writeStatsCheck(cout, true);
+}
+
+bool HostelManager::findStudents(const string& query, const string& field, const string& mode,
+                                 const string& page) {
+    index.prepareSearch(students);
+    return writeSearch(query, field, mode, page, cout);
+}
+
+bool HostelManager::serve(const string& socketPath) {
+    HostelServer server(*this);
+    if (!server.run(socketPath)) return false;
+    // Sessions journalled their changes; fold them into the CSVs once
+    if (journal.size() > 0) compactData(cout);
+    return true;
+}
+
+// Read-only bodies of the commands above, shared with HostelServer
+bool HostelManager::writeReports(const Admin& admin, const string& type, const DataVersion* version,
+                                 ostream& out) const {
+    bool all = (type == "all");
+    if (!all && type != "allocation" && type != "occupancy" && type != "student" && type != "breakdown") {
+        out << "Input Error: Unknown report type: " << type << endl;
+        return false;
+    }
+    // The live counters cover everything but the breakdown, which needs
+    // one aggregation pass
+    bool breakdown = all || type == "breakdown";
+    ReportSummary summary;
+    if (version) summary = breakdown ? ReportEngine::compute(*version, 0) : version->live;
+    else summary = breakdown ? ReportEngine::compute(students, index.roomTable(), 0)
+                             : index.liveStats().summary(index.roomTable());
+    if (all || type == "allocation") admin.generateAllocationReport(summary, out);
+    if (all || type == "occupancy") admin.generateOccupancyReport(summary, out);
+    if (all || type == "student") admin.generateStudentReport(summary, out);
+    if (all || type == "breakdown") admin.generateBreakdownReport(summary, out);
+    return true;
+}
+
+bool HostelManager::writeStatsCheck(ostream& out, bool reservationsIdle) const {
+    // Recount from the records themselves: the index's room table is kept
+    // by the same hooks as the counters, so a missed hook would skew both
+    RoomTable recounted;
+    recounted.rebuild(rooms);
+    ReportSummary recount = ReportEngine::compute(students, recounted, 0);
+    vector<string> drift = index.liveStats().check(index.roomTable(), recount);
+    vector<string> links = index.checkOccupancy(students, rooms, reservationsIdle);
+    if (drift.empty() && links.empty()) {
+        out << "Live statistics consistent (" << recount.totalStudents << " students, "
+            << recount.totalRooms << " rooms)." << endl;
+        return true;
+    }
+    if (!drift.empty()) {
+        out << "Live statistics drifted from a full recount:" << endl;
+        for (const auto& line : drift) out << "  " << line << endl;
+    }
+    if (!links.empty()) {
+        out << "Room occupancy inconsistent:" << endl;
+        for (size_t i = 0; i < links.size() && i < MAX_DRIFT_LINES; ++i) out << "  " << links[i] << endl;
+        if (links.size() > MAX_DRIFT_LINES) {
+            out << "  ... and " << links.size() - MAX_DRIFT_LINES << " more" << endl;
+        }
+    }
+    return false;
+}
+
+bool HostelManager::writeSearch(const string& query, const string& field, const string& mode,
+                                const string& page, ostream& out) const {
+    unsigned fields;
+    SearchIndex::Mode searchMode;
+    if (!SearchIndex::parseField(field, fields)) {
+        out << "Input Error: Unknown search field: " << field << endl;
+        return false;
+    }
+    if (!SearchIndex::parseMode(mode, searchMode)) {
+        out << "Input Error: Unknown search mode: " << mode << endl;
+        return false;
+    }
+    if (page.empty() || page.size() > 9 || page.find_first_not_of("0123456789") != string::npos ||
+        stoul(page) == 0) {
+        out << "Input Error: Page must be a number from 1: " << page << endl;
+        return false;
+    }
+    
+    size_t offset = (stoul(page) - 1) * SEARCH_PAGE_SIZE;
+    SearchIndex::Page found = index.studentSearch().search(query, fields, searchMode,
+                                                           offset, SEARCH_PAGE_SIZE);
+    if (found.total == 0) {
+        out << "No students match \"" << query << "\"." << endl;
+        return false;
+    }
+    if (found.slots.empty()) {
+        out << "Page " << page << " is past the last of " << found.total << " matches." << endl;
+        return false;
+    }
+    out << "Matches " << offset + 1 << "-" << offset + found.slots.size() << " of " << found.total << endl;
+    Admin::displayStudents(students, found.slots, out);
+    return true;
 }
 
 // Admin Operations
@@ -438,7 +1099,7 @@ void HostelManager::displayAdminMenu() {
 
 void HostelManager::displayStudentMenu() {
     cout << "\n=== STUDENT PORTAL ===" << endl;
-    cout << "1. View My Details" << endl;
+    cout << "1. View My Details (search by ID, name, email or course)" << endl;
     cout << "2. View Available Rooms" << endl;
     cout << "3. View Room Details" << endl;
     cout << "4. Back to Main Menu" << endl;
@@ -525,8 +1186,9 @@ void HostelManager::studentManagement() {
         cout << "2. Remove Student" << endl;
         cout << "3. Update Student" << endl;
         cout << "4. Display All Students" << endl;
-        cout << "5. Search Student" << endl;
-        cout << "6. Back to Admin Menu" << endl;
+        cout << "5. Search Students (ID, name, email, course)" << endl;
+        cout << "6. Bulk Import Students (CSV)" << endl;
+        cout << "7. Back to Admin Menu" << endl;
         cout << "Enter your choice: ";
         getline(cin, choice);
         
@@ -535,7 +1197,8 @@ void HostelManager::studentManagement() {
         else if (choice == "3") updateStudent();
         else if (choice == "4") displayAllStudents();
         else if (choice == "5") searchStudent();
-        else if (choice == "6") break;
+        else if (choice == "6") bulkImportStudents();
+        else if (choice == "7") break;
         else cout << "Invalid choice! Please try again." << endl;
         
         pause();
@@ -577,7 +1240,10 @@ void HostelManager::allocationManagement() {
         cout << "2. Deallocate Room" << endl;
         cout << "3. Auto Allocate Rooms" << endl;
         cout << "4. Allocate with Roommate Preference" << endl;
-        cout << "5. Back to Admin Menu" << endl;
+        cout << "5. Optimal Allocation (Room Preferences)" << endl;
+        cout << "6. Block-Partitioned Allocation (Parallel)" << endl;
+        cout << "7. Reshuffle Rooms (moves and swaps from CSV)" << endl;
+        cout << "8. Back to Admin Menu" << endl;
         cout << "Enter your choice: ";
         getline(cin, choice);
         
@@ -585,7 +1251,10 @@ void HostelManager::allocationManagement() {
         else if (choice == "2") deallocateRoom();
         else if (choice == "3") autoAllocateRooms();
         else if (choice == "4") allocateWithRoommatePreference();
-        else if (choice == "5") break;
+        else if (choice == "5") allocateOptimal();
+        else if (choice == "6") allocateByBlock();
+        else if (choice == "7") reshuffleRooms();
+        else if (choice == "8") break;
         else cout << "Invalid choice! Please try again." << endl;
         
         pause();
@@ -600,14 +1269,16 @@ void HostelManager::reportsManagement() {
         cout << "1. Allocation Report" << endl;
         cout << "2. Occupancy Report" << endl;
         cout << "3. Student Report" << endl;
-        cout << "4. Back to Admin Menu" << endl;
+        cout << "4. Block/Floor/Rent Breakdown" << endl;
+        cout << "5. Back to Admin Menu" << endl;
         cout << "Enter your choice: ";
         getline(cin, choice);
         
         if (choice == "1") generateAllocationReport();
         else if (choice == "2") generateOccupancyReport();
         else if (choice == "3") generateStudentReport();
-        else if (choice == "4") break;
+        else if (choice == "4") generateBreakdownReport();
+        else if (choice == "5") break;
         else cout << "Invalid choice! Please try again." << endl;
         
         pause();
@@ -655,8 +1326,24 @@ bool HostelManager::isValidChoice(const string& choice, int maxChoice) const {
 }
 
 // Error Handling
-void HostelManager::handleFileError(const string& operation, const string& filename) const {
-    cout << "Error: Could not " << operation << " file: " << filename << endl;
+void HostelManager::handleFileError(const string& operation, const string& filename,
+                                    ostream& out) const {
+    out << "Error: Could not " << operation << " file: " << filename << endl;
+}
+
+// Empty means the default; anything else must be a number below 2^32
+bool HostelManager::parseSeed(const string& text, uint32_t& seed) const {
+    if (text.empty()) {
+        seed = BlockAllocator::DEFAULT_SEED;
+        return true;
+    }
+    if (text.size() > 10 || text.find_first_not_of("0123456789") != string::npos ||
+        stoull(text) > 0xFFFFFFFFULL) {
+        handleInputError("Seed must be a number from 0 to 4294967295: " + text);
+        return false;
+    }
+    seed = static_cast<uint32_t>(stoull(text));
+    return true;
 }
 
 void HostelManager::handleInputError(const string& message) const {
@@ -26,6 +26,10 @@
 #include "Student.h"
 #include "Room.h"
 #include "Admin.h"
+#include "HostelIndex.h"
+#include "AllocationTransaction.h"
+#include "Journal.h"
+#include "LoadArena.h"
 #include <vector>
 #include <string>
 #include <fstream>
@@ -34,27 +38,62 @@ using namespace std;
 
 class HostelManager {
 private:
+    LoadArena arena;   // payloads of loaded records; declared first so it outlives them
     vector<Student> students;
     vector<Room> rooms;
     vector<Admin> admins;
+    HostelIndex index; // ID/room number -> slot lookups
     Admin* currentAdmin;
     string studentsFile;
     string roomsFile;
     string adminsFile;
+    string journalFile;
+    string snapshotFile;        // binary startup cache of the three CSVs
+    Journal journal;            // append-only log of mutations since the last compaction
+    size_t compactThreshold;    // journal records before folding into the CSVs
+    size_t loadThreads;         // parser threads per file (0 = one per core)
+    static bool arenaLoading;   // new managers load into an arena (default on)
+    
+    // Journal helpers
+    void replayJournal();
+    void applyJournalRecord(const string& op, const string& key, const vector<string>& payload);
+    bool afterJournalWrite(bool logged, ostream& out);
+    Admin& batchAdmin();
+    bool deallocateKeys(const vector<StudentKey>& studentIds);
+    // Bodies of printReports/checkStats/findStudents; they only read, so
+    // server sessions run them concurrently (search must be prepared).
+    // writeReports() takes its figures from version when one is given and
+    // then does not touch the live records at all
+    bool writeReports(const Admin& admin, const string& type, const DataVersion* version,
+                      ostream& out) const;
+    bool writeStatsCheck(ostream& out, bool reservationsIdle) const;
+    bool writeSearch(const string& query, const string& field, const string& mode,
+                     const string& page, ostream& out) const;
+
+    friend class Benchmark;    // times individual phases (benchmark.cpp)
+    friend class HostelServer; // serves sessions from the loaded data
 
 public:
     // Constructor
     HostelManager();
+    HostelManager(const string& studentsPath, const string& roomsPath, const string& adminsPath);
     
     // File Operations
     void loadData();
     void saveData();
     void loadStudents();
-    void saveStudents();
+    bool saveStudents();
     void loadRooms();
-    void saveRooms();
+    bool saveRooms();
     void loadAdmins();
-    void saveAdmins();
+    bool saveAdmins();
+    bool compactData(ostream& out);
+    void reportInvalidStudents() const;
+    bool saveSnapshot();
+    bool loadSnapshot();
+    void setLoadThreads(size_t threads);
+    static void setArenaLoading(bool enabled);
+    size_t loadThreadsFor(size_t bytes) const;
     
     // Authentication
     bool adminLogin();
@@ -68,6 +107,7 @@ public:
     void displayAllStudents();
     void searchStudent();
     void displayStudentDetails();
+    void bulkImportStudents();
     
     // Room Operations
     void addRoom();
@@ -82,11 +122,33 @@ public:
     void deallocateRoom();
     void autoAllocateRooms();
     void allocateWithRoommatePreference();
+    void allocateOptimal();
+    void allocateByBlock();
+    void reshuffleRooms();
+    
+    // Transactions: stage steps on the transaction from beginTransaction(),
+    // then commitTransaction() applies them all or none and journals them
+    // as one record (abort() on the transaction drops them); false if
+    // nothing was applied or the applied steps could not be saved
+    AllocationTransaction beginTransaction();
+    bool commitTransaction(AllocationTransaction& transaction);
     
     // Report Operations
     void generateAllocationReport();
     void generateOccupancyReport();
     void generateStudentReport();
+    void generateBreakdownReport();
+    
+    // Batch Operations (command-line mode, no prompts)
+    bool runAllocation(const string& strategy, const string& seed);
+    bool deallocateStudents(const vector<string>& studentIds);
+    bool deallocateAll();
+    bool importStudents(const string& path, const string& rejectsPath);
+    bool reshuffle(const string& path);
+    bool printReports(const string& type);
+    bool checkStats();
+    bool findStudents(const string& query, const string& field, const string& mode, const string& page);
+    bool serve(const string& socketPath);
     
     // Admin Operations
     void changeAdminPassword();
@@ -109,9 +171,10 @@ public:
     void clearScreen();
     void pause();
     bool isValidChoice(const string& choice, int maxChoice) const;
+    bool parseSeed(const string& text, uint32_t& seed) const;
     
     // Error Handling
-    void handleFileError(const string& operation, const string& filename) const;
+    void handleFileError(const string& operation, const string& filename, ostream& out) const;
     void handleInputError(const string& message) const;
     void handleSystemError(const string& message) const;
 };
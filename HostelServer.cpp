@@ -0,0 +1,615 @@
+#include "HostelServer.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+    // Rooms listed per page of the rooms command
+    const size_t ROOMS_PAGE_SIZE = 20;
+
+    vector<string> splitWords(const string& line) {
+        vector<string> words;
+        istringstream in(line);
+        string word;
+        while (in >> word) words.push_back(word);
+        return words;
+    }
+
+    // The line after its first count words, trimmed (passwords and search
+    // queries may contain spaces)
+    string restOfLine(const string& line, size_t count) {
+        size_t pos = 0;
+        for (size_t w = 0; w < count; ++w) {
+            pos = line.find_first_not_of(" \t", pos);
+            if (pos == string::npos) return "";
+            pos = line.find_first_of(" \t", pos);
+            if (pos == string::npos) return "";
+        }
+        size_t first = line.find_first_not_of(" \t", pos);
+        if (first == string::npos) return "";
+        size_t last = line.find_last_not_of(" \t");
+        return line.substr(first, last - first + 1);
+    }
+
+    bool parsePage(const string& text, size_t& page) {
+        if (text.empty() || text.size() > 9 || text.find_first_not_of("0123456789") != string::npos) {
+            return false;
+        }
+        page = stoul(text);
+        return page > 0;
+    }
+
+#ifndef _WIN32
+    // Connections beyond this are turned away
+    const size_t MAX_SESSIONS = 64;
+    // Longest request line accepted
+    const size_t MAX_LINE = 4096;
+    // How often the accept loop looks at the stop flags
+    const int ACCEPT_POLL_MS = 200;
+
+    volatile sig_atomic_t stopSignal = 0;
+
+    void onStopSignal(int) {
+        stopSignal = 1;
+    }
+
+    // An export is sent in pieces of about this size
+    const size_t EXPORT_SEND_BYTES = 1 << 16;
+
+    // Appends body's lines, each starting '.' given a second one
+    void appendStuffed(string& reply, const string& body) {
+        size_t start = 0;
+        while (start < body.size()) {
+            size_t end = body.find('\n', start);
+            if (end == string::npos) end = body.size();
+            if (body[start] == '.') reply += '.';
+            reply.append(body, start, end - start);
+            reply += '\n';
+            start = end + 1;
+        }
+    }
+
+    // Status line, dot-stuffed body, terminating "."
+    string frameReply(bool ok, const string& body) {
+        string reply = ok ? "OK\n" : "ERR\n";
+        appendStuffed(reply, body);
+        reply += ".\n";
+        return reply;
+    }
+
+    bool sendAll(int fd, const string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // Buffered line reads from a socket; '\r' before '\n' is dropped
+    class LineReader {
+    private:
+        int fd;
+        string buffer;
+        size_t start = 0;
+
+    public:
+        explicit LineReader(int socketFd) : fd(socketFd) {}
+
+        // False at end of stream, on error, or for an overlong line
+        bool next(string& line) {
+            while (true) {
+                size_t end = buffer.find('\n', start);
+                if (end != string::npos) {
+                    size_t length = end - start;
+                    if (length > 0 && buffer[end - 1] == '\r') length--;
+                    line.assign(buffer, start, length);
+                    start = end + 1;
+                    return true;
+                }
+                buffer.erase(0, start);
+                start = 0;
+                if (buffer.size() > MAX_LINE) return false;
+                char chunk[4096];
+                ssize_t n = read(fd, chunk, sizeof(chunk));
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return false;
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+        }
+    };
+
+    bool fillAddress(const string& path, sockaddr_un& address) {
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) return false;
+        memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    int connectTo(const sockaddr_un& address) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+#endif
+
+    void printHelp(ostream& out) {
+        out << "Commands:" << endl;
+        out << "  student ID                       student details" << endl;
+        out << "  room NUMBER                      room details" << endl;
+        out << "  rooms [PAGE]                     rooms with free beds, " << ROOMS_PAGE_SIZE << " per page" << endl;
+        out << "  search [--field=any|name|email|course] [--mode=prefix|contains] [--page=N] QUERY" << endl;
+        out << "  login USERNAME PASSWORD          unlocks the commands below" << endl;
+        out << "  logout" << endl;
+        out << "  report [allocation|occupancy|student|breakdown|all]" << endl;
+        out << "  export students|rooms            all records as CSV rows" << endl;
+        out << "  allocate STUDENT_ID ROOM_NUMBER" << endl;
+        out << "  dealloc STUDENT_ID" << endl;
+        out << "  check                            verify live statistics" << endl;
+        out << "  shutdown                         stop the server" << endl;
+        out << "  quit                             close this session" << endl;
+    }
+}
+
+HostelServer::HostelServer(HostelManager& manager) : manager(manager), listenFd(-1) {}
+
+HostelServer::~HostelServer() {
+#ifndef _WIN32
+    if (listenFd >= 0) close(listenFd);
+#endif
+}
+
+// Server lifetime
+bool HostelServer::run(const string& path) {
+#ifdef _WIN32
+    (void)path;
+    cout << "Server mode needs Unix domain sockets, which this build does not support." << endl;
+    return false;
+#else
+    if (!listenOn(path)) return false;
+    // No session is running yet; from here on writers keep both current
+    manager.index.prepareSearch(manager.students);
+    manager.index.publishVersion(manager.students, manager.rooms);
+
+    // A client that disconnects mid-reply must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+    stopSignal = 0;
+    auto previousInt = signal(SIGINT, onStopSignal);
+    auto previousTerm = signal(SIGTERM, onStopSignal);
+
+    cout << "Serving " << manager.students.size() << " students and " << manager.rooms.size()
+         << " rooms on " << path << " (Ctrl+C or 'shutdown' to stop)" << endl;
+    acceptLoop();
+
+    // Wake sessions blocked in read; each finishes its current request
+    stopping = true;
+    {
+        lock_guard<mutex> guard(sessionsLock);
+        for (auto& session : sessions) shutdown(session->fd, SHUT_RDWR);
+    }
+    reapSessions(true);
+    close(listenFd);
+    listenFd = -1;
+    unlink(path.c_str());
+    signal(SIGINT, previousInt);
+    signal(SIGTERM, previousTerm);
+    cout << "Server stopped." << endl;
+    return true;
+#endif
+}
+
+#ifndef _WIN32
+bool HostelServer::listenOn(const string& path) {
+    sockaddr_un address;
+    if (!fillAddress(path, address)) {
+        cout << "Error: Socket path must be 1 to " << sizeof(address.sun_path) - 1
+             << " characters: " << path << endl;
+        return false;
+    }
+
+    // A socket file left behind by a server that is gone is replaced; a
+    // live server or a file that is not a socket is left alone
+    struct stat info;
+    if (lstat(path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            cout << "Error: " << path << " exists and is not a socket." << endl;
+            return false;
+        }
+        int probe = connectTo(address);
+        if (probe >= 0) {
+            close(probe);
+            cout << "Error: A server is already listening on " << path << endl;
+            return false;
+        }
+        unlink(path.c_str());
+    }
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 ||
+        bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0) {
+        cout << "Error: Could not listen on " << path << ": " << strerror(errno) << endl;
+        if (listenFd >= 0) close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    return true;
+}
+
+void HostelServer::acceptLoop() {
+    while (!stopping && !stopSignal) {
+        pollfd waiting = {listenFd, POLLIN, 0};
+        int ready = poll(&waiting, 1, ACCEPT_POLL_MS);
+        reapSessions(false);
+        if (ready <= 0) continue;
+
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) continue;
+        lock_guard<mutex> guard(sessionsLock);
+        if (sessions.size() >= MAX_SESSIONS) {
+            sendAll(fd, frameReply(false, "Server busy, try again later.\n"));
+            close(fd);
+            continue;
+        }
+        sessions.push_back(make_unique<Session>());
+        Session& session = *sessions.back();
+        session.fd = fd;
+        session.adminSlot = NO_ADMIN;
+        session.replied = false;
+        session.worker = thread(&HostelServer::serveSession, this, ref(session));
+    }
+}
+
+// Finished sessions (or all of them) are joined and their sockets closed
+void HostelServer::reapSessions(bool all) {
+    list<unique_ptr<Session>> finished;
+    {
+        lock_guard<mutex> guard(sessionsLock);
+        for (auto it = sessions.begin(); it != sessions.end();) {
+            auto next = std::next(it);
+            if (all || (*it)->done) finished.splice(finished.end(), sessions, it);
+            it = next;
+        }
+    }
+    for (auto& session : finished) {
+        session->worker.join();
+        close(session->fd);
+    }
+}
+
+void HostelServer::serveSession(Session& session) {
+    LineReader reader(session.fd);
+    string line;
+    bool closing = false;
+    while (!closing && !stopping && reader.next(line)) {
+        ostringstream out;
+        session.replied = false;
+        bool ok = handle(session, line, out, closing);
+        if (session.replied) {
+            if (!ok) break;
+            continue;
+        }
+        if (!sendAll(session.fd, frameReply(ok, out.str()))) break;
+    }
+    // The socket stays open until the session is reaped, so shutdown()
+    // from run() can never reach a reused descriptor
+    shutdown(session.fd, SHUT_RDWR);
+    session.done = true;
+}
+
+// The reply goes out as it is produced: an export is far larger than any
+// other reply, and the pinned version keeps it consistent however long the
+// client takes to read it
+bool HostelServer::exportRecords(Session& session, bool students) {
+    shared_ptr<const DataVersion> version = manager.index.pinVersion();
+    session.replied = true;
+    size_t count = students ? version->students.size() : version->rooms.size();
+    string reply = "OK\n";
+    ostringstream record;
+    for (size_t slot = 0; slot < count; ++slot) {
+        record.str("");
+        if (students) version->students[slot].saveToFile(record);
+        else version->rooms[slot].saveToFile(record);
+        appendStuffed(reply, record.str());
+        if (reply.size() >= EXPORT_SEND_BYTES) {
+            if (!sendAll(session.fd, reply)) return false;
+            reply.clear();
+        }
+    }
+    reply += ".\n";
+    return sendAll(session.fd, reply);
+}
+#else
+bool HostelServer::listenOn(const string&) { return false; }
+void HostelServer::acceptLoop() {}
+void HostelServer::reapSessions(bool) {}
+void HostelServer::serveSession(Session&) {}
+bool HostelServer::exportRecords(Session&, bool) { return false; }
+#endif
+
+// Requests
+// Waits out any writer that got its turn first, so readers arriving
+// behind a pending allocation do not overtake it
+shared_lock<shared_mutex> HostelServer::readLock() {
+    lock_guard<mutex> turn(writerTurn);
+    return shared_lock<shared_mutex>(dataLock);
+}
+
+bool HostelServer::handle(Session& session, const string& line, ostream& out, bool& closing) {
+    vector<string> words = splitWords(line);
+    if (words.empty()) {
+        out << "Empty command; try 'help'." << endl;
+        return false;
+    }
+    const string& command = words[0];
+    auto usage = [&](size_t minArgs, size_t maxArgs, const char* form) {
+        if (words.size() - 1 >= minArgs && words.size() - 1 <= maxArgs) return true;
+        out << "Usage: " << form << endl;
+        return false;
+    };
+
+    if (command == "help") {
+        printHelp(out);
+        return true;
+    }
+    if (command == "quit") {
+        closing = true;
+        out << "Goodbye." << endl;
+        return true;
+    }
+    if (command == "student") return usage(1, 1, "student ID") && showStudent(words[1], out);
+    if (command == "room") return usage(1, 1, "room NUMBER") && showRoom(words[1], out);
+    if (command == "rooms") return usage(0, 1, "rooms [PAGE]") && listFreeRooms(words.size() > 1 ? words[1] : "1", out);
+    if (command == "search") return search(words, restOfLine(line, 1), out);
+    if (command == "login") {
+        if (words.size() < 3) return usage(2, 2, "login USERNAME PASSWORD");
+        string password = restOfLine(line, 2);
+        shared_lock<shared_mutex> read = readLock();
+        for (size_t slot = 0; slot < manager.admins.size(); ++slot) {
+            if (manager.admins[slot].authenticate(words[1], password)) {
+                session.adminSlot = slot;
+                out << "Welcome, " << manager.admins[slot].getName() << "!" << endl;
+                return true;
+            }
+        }
+        out << "Invalid username or password!" << endl;
+        return false;
+    }
+    if (command == "logout") {
+        session.adminSlot = NO_ADMIN;
+        out << "Logged out." << endl;
+        return true;
+    }
+
+    bool known = command == "report" || command == "export" || command == "allocate" || command == "dealloc" ||
+                 command == "check" || command == "shutdown";
+    if (!known) {
+        out << "Unknown command: " << command << " (try 'help')" << endl;
+        return false;
+    }
+    if (session.adminSlot == NO_ADMIN) {
+        out << "Please login as admin first!" << endl;
+        return false;
+    }
+    if (command == "report") {
+        if (!usage(0, 1, "report [allocation|occupancy|student|breakdown|all]")) return false;
+        // Sessions never change the admin accounts, so only the version is needed
+        shared_ptr<const DataVersion> version = manager.index.pinVersion();
+        return manager.writeReports(manager.admins[session.adminSlot],
+                                    words.size() > 1 ? words[1] : "all", version.get(), out);
+    }
+    if (command == "export") {
+        if (!usage(1, 1, "export students|rooms")) return false;
+        if (words[1] != "students" && words[1] != "rooms") {
+            out << "Input Error: Unknown table: " << words[1] << endl;
+            return false;
+        }
+        return exportRecords(session, words[1] == "students");
+    }
+    if (command == "check") {
+        if (!usage(0, 0, "check")) return false;
+        shared_lock<shared_mutex> read = readLock();
+        // Another session may hold a bed reservation between its two locks
+        return manager.writeStatsCheck(out, false);
+    }
+    if (command == "allocate") {
+        return usage(2, 2, "allocate STUDENT_ID ROOM_NUMBER") && allocate(session, words[1], words[2], out);
+    }
+    if (command == "dealloc") return usage(1, 1, "dealloc STUDENT_ID") && deallocate(session, words[1], out);
+
+    closing = true;
+    stopping = true;
+    out << "Server shutting down." << endl;
+    return true;
+}
+
+bool HostelServer::showStudent(const string& studentId, ostream& out) {
+    shared_lock<shared_mutex> read = readLock();
+    size_t slot = manager.index.studentSlot(Keys::findStudent(studentId));
+    if (slot == HostelIndex::npos) {
+        out << "Student not found!" << endl;
+        return false;
+    }
+    manager.students[slot].displayInfo(out);
+    return true;
+}
+
+bool HostelServer::showRoom(const string& roomNumber, ostream& out) {
+    shared_lock<shared_mutex> read = readLock();
+    size_t slot = manager.index.roomSlot(Keys::findRoom(roomNumber));
+    if (slot == HostelIndex::npos) {
+        out << "Room not found!" << endl;
+        return false;
+    }
+    manager.rooms[slot].displayInfo(out);
+    return true;
+}
+
+bool HostelServer::listFreeRooms(const string& page, ostream& out) {
+    size_t number;
+    if (!parsePage(page, number)) {
+        out << "Input Error: Page must be a number from 1: " << page << endl;
+        return false;
+    }
+    shared_lock<shared_mutex> read = readLock();
+    const RoomTable& table = manager.index.roomTable();
+    const int32_t* capacity = table.capacity();
+    const int32_t* occupancy = table.occupancy();
+    size_t offset = (number - 1) * ROOMS_PAGE_SIZE;
+    // The availability buckets give the total; the scan stops at the page
+    size_t total = manager.index.countRoomsWithSlots(1);
+    size_t seen = 0;
+    vector<size_t> slots;
+    for (size_t slot = 0; slot < table.size() && slots.size() < ROOMS_PAGE_SIZE; ++slot) {
+        if (occupancy[slot] >= capacity[slot]) continue;
+        if (seen++ >= offset) slots.push_back(slot);
+    }
+    if (total == 0) {
+        out << "No rooms have free beds." << endl;
+        return true;
+    }
+    if (slots.empty()) {
+        out << "Page " << page << " is past the last of " << total << " rooms." << endl;
+        return false;
+    }
+    out << "Rooms with free beds " << offset + 1 << "-" << offset + slots.size() << " of " << total << endl;
+    Admin::displayRooms(manager.rooms, slots, out);
+    return true;
+}
+
+bool HostelServer::search(const vector<string>& words, const string& arguments, ostream& out) {
+    // Options first, then the query (which may contain spaces)
+    string field = "any", mode = "prefix", page = "1";
+    size_t options = 0;
+    for (size_t w = 1; w < words.size() && words[w].compare(0, 2, "--") == 0; ++w, ++options) {
+        const string& option = words[w];
+        if (option.compare(0, 8, "--field=") == 0) field = option.substr(8);
+        else if (option.compare(0, 7, "--mode=") == 0) mode = option.substr(7);
+        else if (option.compare(0, 7, "--page=") == 0) page = option.substr(7);
+        else {
+            out << "Input Error: Unknown search option: " << option << endl;
+            return false;
+        }
+    }
+    string query = restOfLine(arguments, options);
+    if (query.empty()) {
+        out << "Usage: search [--field=any|name|email|course] [--mode=prefix|contains] [--page=N] QUERY" << endl;
+        return false;
+    }
+    shared_lock<shared_mutex> read = readLock();
+    return manager.writeSearch(query, field, mode, page, out);
+}
+
+// Writes: the Admin methods and any save error report straight into the reply
+bool HostelServer::allocate(Session& session, const string& studentId, const string& roomNumber,
+                            ostream& out) {
+    // The bed is claimed under the shared lock, so requests for a full room
+    // are turned away without queueing for the writer lock; the claim holds
+    // the bed until the commit (sessions never add or remove rooms, so the
+    // slot stays valid between the two locks)
+    RoomKey roomKey = Keys::findRoom(roomNumber);
+    size_t roomSlot;
+    {
+        shared_lock<shared_mutex> read = readLock();
+        roomSlot = manager.index.roomSlot(roomKey);
+        if (roomSlot != HostelIndex::npos && !manager.index.reserveBed(roomSlot)) {
+            out << "Room is full!" << endl;
+            return false;
+        }
+    }
+
+    lock_guard<mutex> turn(writerTurn);
+    unique_lock<shared_mutex> write(dataLock);
+    Admin& admin = manager.admins[session.adminSlot];
+    StudentKey studentKey = Keys::findStudent(studentId);
+    bool ok = (roomSlot == HostelIndex::npos)
+        ? admin.allocateRoom(manager.students, manager.rooms, manager.index, studentKey, roomKey, out)
+        : admin.commitAllocation(manager.students, manager.rooms, manager.index, studentKey, roomKey, out);
+    if (ok) ok = manager.afterJournalWrite(manager.journal.logAllocate(studentId, roomNumber), out);
+    manager.index.prepareSearch(manager.students);
+    manager.index.publishVersion(manager.students, manager.rooms);
+    return ok;
+}
+
+bool HostelServer::deallocate(Session& session, const string& studentId, ostream& out) {
+    lock_guard<mutex> turn(writerTurn);
+    unique_lock<shared_mutex> write(dataLock);
+    bool ok = manager.admins[session.adminSlot].deallocateRoom(
+        manager.students, manager.rooms, manager.index, Keys::findStudent(studentId), out);
+    if (ok) ok = manager.afterJournalWrite(manager.journal.logDeallocate(studentId), out);
+    manager.index.prepareSearch(manager.students);
+    manager.index.publishVersion(manager.students, manager.rooms);
+    return ok;
+}
+
+// Client
+bool HostelServer::runClient(const string& path, istream& input, ostream& output) {
+#ifdef _WIN32
+    (void)path;
+    (void)input;
+    output << "Client mode needs Unix domain sockets, which this build does not support." << endl;
+    return false;
+#else
+    sockaddr_un address;
+    if (!fillAddress(path, address)) {
+        output << "Error: Socket path must be 1 to " << sizeof(address.sun_path) - 1
+               << " characters: " << path << endl;
+        return false;
+    }
+    int fd = connectTo(address);
+    if (fd < 0) {
+        output << "Error: Could not connect to " << path << ": " << strerror(errno) << endl;
+        return false;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    LineReader reader(fd);
+    bool allOk = true;
+    string request, line;
+    while (getline(input, request)) {
+        vector<string> words = splitWords(request);
+        if (words.empty() || words[0][0] == '#') continue;
+        if (!sendAll(fd, request + "\n") || !reader.next(line)) {
+            output << "Connection closed by server." << endl;
+            allOk = false;
+            break;
+        }
+        if (line != "OK") allOk = false;
+        bool complete = false;
+        while (reader.next(line)) {
+            if (line == ".") {
+                complete = true;
+                break;
+            }
+            output << (line[0] == '.' ? line.substr(1) : line) << endl;
+        }
+        if (!complete) {
+            output << "Connection closed by server." << endl;
+            allOk = false;
+            break;
+        }
+        if (words[0] == "quit" || words[0] == "shutdown") break;
+    }
+    close(fd);
+    return allOk;
+#endif
+}
@@ -0,0 +1,111 @@
+/**
+ * @file HostelServer.h
+ * @brief Local Multi-Session Server over a Unix Domain Socket
+ *
+ * One process keeps the data loaded and serves many local sessions at
+ * once, each on its own connection and thread. A request is one line; the
+ * reply is a status line ("OK" or "ERR"), the command's output and a line
+ * holding a single ".". Output lines that start with '.' get a second '.'
+ * in front, as in SMTP.
+ *
+ * Locking:
+ * - Lookups (student, room, rooms, search, check) share dataLock and
+ *   write their output into a per-request buffer, so they run in parallel.
+ * - report and export take no lock at all: they pin the current record
+ *   version (DataVersions) and work from it, so a long report or export
+ *   sees one consistent state and never delays a commit. export streams
+ *   its rows as they are produced instead of buffering the reply.
+ * - allocate first reserves the bed (RoomReservations, one CAS) under the
+ *   shared lock, so requests racing for a full room are refused without
+ *   waiting; sessions never add or remove rooms, so the slot stays valid.
+ * - Commits (allocate, dealloc) hold dataLock exclusively: they touch the
+ *   room, the student, the availability buckets, the live counters and the
+ *   journal, which are shared by every room. Once a write is waiting, new
+ *   readers queue behind it (writerTurn), so a steady stream of reads
+ *   cannot starve allocations.
+ * - The search index and the record version are brought up to date by
+ *   each writer before it releases the lock, so readers only ever query
+ *   them.
+ *
+ * Commands: help, login USER PASS, logout, student ID, room NUMBER,
+ * rooms [PAGE], search [--field=F] [--mode=M] [--page=N] QUERY, quit;
+ * once logged in also report [TYPE], export students|rooms (CSV rows as
+ * in the data files), allocate STUDENT ROOM, dealloc STUDENT, check and
+ * shutdown.
+ *
+ * runClient() is the matching client: it sends each line read from its
+ * input and prints the replies.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef HOSTELSERVER_H
+#define HOSTELSERVER_H
+
+#include "HostelManager.h"
+#include <atomic>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+class HostelServer {
+private:
+    struct Session {
+        int fd;
+        thread worker;
+        atomic<bool> done{false};
+        size_t adminSlot;     // logged-in admin account, NO_ADMIN when none
+        bool replied;         // the request sent its own reply (export)
+    };
+
+    HostelManager& manager;
+    int listenFd;
+    atomic<bool> stopping{false};
+    shared_mutex dataLock;    // students, rooms, index and journal
+    mutex writerTurn;         // taken by writers ahead of dataLock
+    mutex sessionsLock;
+    list<unique_ptr<Session>> sessions;
+
+    shared_lock<shared_mutex> readLock();
+    bool listenOn(const string& path);
+    void acceptLoop();
+    void reapSessions(bool all);
+    void serveSession(Session& session);
+    bool handle(Session& session, const string& line, ostream& out, bool& closing);
+
+    // Read-only commands (run under a shared lock)
+    bool showStudent(const string& studentId, ostream& out);
+    bool showRoom(const string& roomNumber, ostream& out);
+    bool listFreeRooms(const string& page, ostream& out);
+    bool search(const vector<string>& words, const string& arguments, ostream& out);
+    // Lock-free: streams a pinned version; false if the client went away
+    bool exportRecords(Session& session, bool students);
+    // Writes (run under the exclusive lock)
+    bool allocate(Session& session, const string& studentId, const string& roomNumber, ostream& out);
+    bool deallocate(Session& session, const string& studentId, ostream& out);
+
+public:
+    static const size_t NO_ADMIN = static_cast<size_t>(-1);
+
+    explicit HostelServer(HostelManager& manager);
+    ~HostelServer();
+
+    // Serves until a session sends shutdown or the process gets
+    // SIGINT/SIGTERM; false if the socket could not be opened
+    bool run(const string& path);
+
+    // Sends every line of input to the server at path and prints the
+    // replies to output; false if the connection failed or any reply
+    // was an error
+    static bool runClient(const string& path, istream& input, ostream& output);
+};
+
+#endif // HOSTELSERVER_H
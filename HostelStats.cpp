@@ -0,0 +1,165 @@
+#include "HostelStats.h"
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+    void compareFigure(vector<string>& out, const string& name, int live, int recount) {
+        if (live != recount) {
+            out.push_back(name + ": live " + to_string(live) + ", recount " + to_string(recount));
+        }
+    }
+
+    bool sameTally(const ReportSummary::Tally& a, const ReportSummary::Tally& b) {
+        return a.rooms == b.rooms && a.capacity == b.capacity && a.occupancy == b.occupancy;
+    }
+
+    bool sameTally(int a, int b) {
+        return a == b;
+    }
+
+    // Groups are matched by key; one line per group that differs
+    template <typename Key, typename Value>
+    void compareGroups(vector<string>& out, const string& name,
+                       const vector<pair<Key, Value>>& live, const vector<pair<Key, Value>>& recount) {
+        map<Key, pair<const Value*, const Value*>> groups;
+        for (const auto& group : live) groups[group.first].first = &group.second;
+        for (const auto& group : recount) groups[group.first].second = &group.second;
+        for (const auto& group : groups) {
+            const Value* a = group.second.first;
+            const Value* b = group.second.second;
+            if (a && b && sameTally(*a, *b)) continue;
+            ostringstream line;
+            line << name << " " << group.first << ": "
+                 << (!a ? "missing from live counters" : !b ? "only in live counters" : "counts differ");
+            out.push_back(line.str());
+        }
+    }
+}
+
+// Students
+void HostelStats::countStudent(size_t slot, int sign) {
+    allocatedStudents += sign * studentAllocated[slot];
+    byCourse[studentCourse[slot]] += sign;
+    int& year = byYear[studentYear[slot]];
+    year += sign;
+    if (year == 0) byYear.erase(studentYear[slot]);
+}
+
+void HostelStats::resetStudents() {
+    allocatedStudents = 0;
+    fill(byCourse.begin(), byCourse.end(), 0);
+    byYear.clear();
+    studentCourse.clear();
+    studentYear.clear();
+    studentAllocated.clear();
+}
+
+void HostelStats::studentAppended(const Student& student) {
+    uint32_t course = courseNames.intern(student.getCourse());
+    if (course >= byCourse.size()) byCourse.resize(course + 1, 0);
+    studentCourse.push_back(course);
+    studentYear.push_back(student.getYear());
+    studentAllocated.push_back(student.getIsAllocated() ? 1 : 0);
+    countStudent(studentCourse.size() - 1, +1);
+}
+
+void HostelStats::studentChanged(size_t slot, const Student& student) {
+    if (slot >= studentCourse.size()) return;
+    countStudent(slot, -1);
+    uint32_t course = courseNames.intern(student.getCourse());
+    if (course >= byCourse.size()) byCourse.resize(course + 1, 0);
+    studentCourse[slot] = course;
+    studentYear[slot] = student.getYear();
+    studentAllocated[slot] = student.getIsAllocated() ? 1 : 0;
+    countStudent(slot, +1);
+}
+
+void HostelStats::studentErased(size_t slot) {
+    if (slot >= studentCourse.size()) return;
+    countStudent(slot, -1);
+    studentCourse.erase(studentCourse.begin() + slot);
+    studentYear.erase(studentYear.begin() + slot);
+    studentAllocated.erase(studentAllocated.begin() + slot);
+}
+
+// Rooms
+void HostelStats::resetRooms() {
+    roomCount = 0;
+    occupiedRooms = 0;
+    totalCapacity = 0;
+    totalOccupancy = 0;
+    byType.clear();
+}
+
+void HostelStats::addRoom(const RoomTable& rooms, size_t slot) {
+    int capacity = rooms.capacity()[slot];
+    int occupancy = rooms.occupancy()[slot];
+    uint32_t type = rooms.type()[slot];
+    roomCount++;
+    occupiedRooms += (occupancy != 0);
+    totalCapacity += capacity;
+    totalOccupancy += occupancy;
+    if (type >= byType.size()) byType.resize(type + 1);
+    byType[type].rooms++;
+    byType[type].capacity += capacity;
+    byType[type].occupancy += occupancy;
+}
+
+void HostelStats::removeRoom(const RoomTable& rooms, size_t slot) {
+    if (slot >= rooms.size()) return;
+    int capacity = rooms.capacity()[slot];
+    int occupancy = rooms.occupancy()[slot];
+    uint32_t type = rooms.type()[slot];
+    roomCount--;
+    occupiedRooms -= (occupancy != 0);
+    totalCapacity -= capacity;
+    totalOccupancy -= occupancy;
+    if (type < byType.size()) {
+        byType[type].rooms--;
+        byType[type].capacity -= capacity;
+        byType[type].occupancy -= occupancy;
+    }
+}
+
+// Reads
+ReportSummary HostelStats::summary(const RoomTable& rooms) const {
+    ReportSummary result;
+    result.totalStudents = static_cast<int>(studentCourse.size());
+    result.allocatedStudents = allocatedStudents;
+    result.totalRooms = roomCount;
+    result.occupiedRooms = occupiedRooms;
+    result.totalCapacity = totalCapacity;
+    result.totalOccupancy = totalOccupancy;
+    for (size_t code = 0; code < byType.size(); ++code) {
+        if (byType[code].rooms == 0) continue;
+        result.byType.emplace_back(rooms.types().name(static_cast<uint32_t>(code)), byType[code]);
+    }
+    sort(result.byType.begin(), result.byType.end(),
+         [](const pair<string, ReportSummary::Tally>& a, const pair<string, ReportSummary::Tally>& b) {
+             return a.first < b.first;
+         });
+    for (size_t code = 0; code < byCourse.size(); ++code) {
+        if (byCourse[code] == 0) continue;
+        result.byCourse.emplace_back(courseNames.name(static_cast<uint32_t>(code)), byCourse[code]);
+    }
+    sort(result.byCourse.begin(), result.byCourse.end());
+    result.byYear.assign(byYear.begin(), byYear.end());
+    return result;
+}
+
+vector<string> HostelStats::check(const RoomTable& rooms, const ReportSummary& recount) const {
+    ReportSummary live = summary(rooms);
+    vector<string> drift;
+    compareFigure(drift, "students", live.totalStudents, recount.totalStudents);
+    compareFigure(drift, "allocated students", live.allocatedStudents, recount.allocatedStudents);
+    compareFigure(drift, "rooms", live.totalRooms, recount.totalRooms);
+    compareFigure(drift, "occupied rooms", live.occupiedRooms, recount.occupiedRooms);
+    compareFigure(drift, "capacity", live.totalCapacity, recount.totalCapacity);
+    compareFigure(drift, "occupancy", live.totalOccupancy, recount.totalOccupancy);
+    compareGroups(drift, "type", live.byType, recount.byType);
+    compareGroups(drift, "course", live.byCourse, recount.byCourse);
+    compareGroups(drift, "year", live.byYear, recount.byYear);
+    return drift;
+}
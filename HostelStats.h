@@ -0,0 +1,77 @@
+/**
+ * @file HostelStats.h
+ * @brief Live Counters Behind the Summary Reports
+ *
+ * Keeps the totals the allocation, occupancy and student reports print
+ * (students, allocated students, rooms, occupied rooms, capacity,
+ * occupancy, and tallies per room type, course and year) up to date as
+ * records change, so those reports read counters instead of scanning.
+ *
+ * HostelIndex owns one instance and drives it from its maintenance hooks.
+ * Room contributions are taken from the RoomTable row just before and
+ * just after the row is rewritten; student contributions come from a
+ * small per-slot copy of the counted fields, so a changed record can be
+ * diffed against what was counted for it.
+ *
+ * check() compares the counters with a from-scratch ReportEngine pass
+ * and lists every figure that drifted.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef HOSTELSTATS_H
+#define HOSTELSTATS_H
+
+#include "Student.h"
+#include "RoomTable.h"
+#include "ReportEngine.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class HostelStats {
+private:
+    int allocatedStudents = 0;
+    int roomCount = 0;
+    int occupiedRooms = 0;
+    int totalCapacity = 0;
+    int totalOccupancy = 0;
+
+    vector<ReportSummary::Tally> byType; // indexed by RoomTable type code
+    StringPool courseNames;
+    vector<int> byCourse;                // indexed by courseNames code
+    map<int, int> byYear;
+
+    // What was counted for each student slot
+    vector<uint32_t> studentCourse;
+    vector<int> studentYear;
+    vector<uint8_t> studentAllocated;
+
+    void countStudent(size_t slot, int sign);
+
+public:
+    // Students (slots follow the students vector)
+    void resetStudents();
+    void studentAppended(const Student& student);
+    void studentChanged(size_t slot, const Student& student);
+    void studentErased(size_t slot);
+
+    // Rooms: add a table row after writing it, remove it before rewriting it
+    void resetRooms();
+    void addRoom(const RoomTable& rooms, size_t slot);
+    void removeRoom(const RoomTable& rooms, size_t slot);
+
+    // Allocation, occupancy and student figures without a scan (the
+    // block/floor/rent breakdown stays empty)
+    ReportSummary summary(const RoomTable& rooms) const;
+
+    // Differences against a full recount; empty when consistent
+    vector<string> check(const RoomTable& rooms, const ReportSummary& recount) const;
+};
+
+#endif // HOSTELSTATS_H
@@ -0,0 +1,123 @@
+#include "Journal.h"
+#include "CsvUtils.h"
+#include <sstream>
+#include <filesystem>
+
+using namespace std;
+
+// Constructor
+Journal::Journal() : path(""), recordCount(0), completeBytes(0), tornTail(false) {}
+
+// Lifecycle
+bool Journal::open(const string& filename) {
+    close();
+    if (tornTail && filename == path) {
+        error_code ec;
+        filesystem::resize_file(path, completeBytes, ec);
+        if (ec) return false;
+    }
+    tornTail = false;
+    path = filename;
+    out.open(path, ios::app);
+    return out.is_open();
+}
+
+void Journal::close() {
+    if (out.is_open()) out.close();
+}
+
+bool Journal::truncate() {
+    close();
+    ofstream reset(path, ios::trunc);
+    if (!reset.is_open()) return false;
+    reset.close();
+    recordCount = 0;
+    tornTail = false;
+    out.open(path, ios::app);
+    return out.is_open();
+}
+
+size_t Journal::size() const {
+    return recordCount;
+}
+
+// Appending
+bool Journal::writeRecord(const string& record) {
+    if (!out.is_open()) return false;
+    // One write per record, flushed so a crash loses at most the record in flight
+    out << record;
+    out.flush();
+    if (!out) return false;
+    recordCount++;
+    return true;
+}
+
+bool Journal::logAllocate(const string& studentId, const string& roomNumber) {
+    return writeRecord("A," + csvEscape(studentId) + ',' + csvEscape(roomNumber) + '\n');
+}
+
+bool Journal::logDeallocate(const string& studentId) {
+    return writeRecord("D," + csvEscape(studentId) + '\n');
+}
+
+bool Journal::logStudent(const string& key, const Student& student) {
+    ostringstream record;
+    record << "S," << csvEscape(key) << ',';
+    student.saveToFile(record);
+    return writeRecord(record.str());
+}
+
+bool Journal::logRemoveStudent(const string& studentId) {
+    return writeRecord("XS," + csvEscape(studentId) + '\n');
+}
+
+bool Journal::logRoom(const string& key, const Room& room) {
+    ostringstream record;
+    record << "R," << csvEscape(key) << ',';
+    room.saveToFile(record);
+    return writeRecord(record.str());
+}
+
+bool Journal::logRemoveRoom(const string& roomNumber) {
+    return writeRecord("XR," + csvEscape(roomNumber) + '\n');
+}
+
+bool Journal::logTransaction(const vector<pair<string, string>>& steps) {
+    // One record, so one write and one flush for the whole batch
+    string record = "T," + to_string(steps.size());
+    for (const auto& step : steps) {
+        if (step.second.empty()) record += ",D," + csvEscape(step.first);
+        else record += ",A," + csvEscape(step.first) + ',' + csvEscape(step.second);
+    }
+    return writeRecord(record + '\n');
+}
+
+// Replay
+size_t Journal::replay(const string& filename,
+                       const function<void(const string&, const string&,
+                                           const vector<string>&)>& apply) {
+    close();
+    path = filename;
+    recordCount = 0;
+    completeBytes = 0;
+    tornTail = false;
+    ifstream in(path, ios::binary);
+    if (!in.is_open()) return 0;
+
+    string record;
+    while (csvReadRecord(in, record)) {
+        // Only a record read up to its newline was written in full
+        if (in.eof()) {
+            tornTail = true;
+            break;
+        }
+        completeBytes = static_cast<uintmax_t>(in.tellg());
+        if (!record.empty() && record.back() == '\r') record.pop_back();
+        vector<string> tokens = csvParseLine(record);
+        if (tokens.size() < 2 || tokens[0].empty()) continue; // blank or torn record
+        vector<string> payload(tokens.begin() + 2, tokens.end());
+        apply(tokens[0], tokens[1], payload);
+        recordCount++;
+    }
+    return recordCount;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file Journal.h
+ * @brief Append-Only Write-Ahead Journal for Hostel Allotment System
+ *
+ * Every mutation (allocate, deallocate, student/room upsert or removal)
+ * is appended to the journal as one small CSV record instead of
+ * rewriting students.csv and rooms.csv. Startup loads the CSV snapshots
+ * and replays the journal on top; compaction folds the journal back into
+ * the snapshots and truncates it.
+ *
+ * Record format: op,key[,payload...]
+ * - A,studentId,roomNumber   allocate
+ * - D,studentId              deallocate
+ * - S,oldStudentId,<student> upsert student (key may differ on re-key)
+ * - XS,studentId             remove student
+ * - R,oldRoomNumber,<room>   upsert room
+ * - XR,roomNumber            remove room
+ * - T,count,step...          transaction: count steps, each A,studentId,
+ *                            roomNumber or D,studentId, applied in order;
+ *                            a record whose steps do not add up to count
+ *                            is torn and replayed not at all
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "Student.h"
+#include "Room.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <functional>
+
+using namespace std;
+
+class Journal {
+private:
+    string path;
+    ofstream out;
+    size_t recordCount;
+    // Length of path up to the end of its last complete record, when the
+    // last replay found a torn record after it
+    uintmax_t completeBytes;
+    bool tornTail;
+
+    bool writeRecord(const string& record);
+
+public:
+    // Constructor
+    Journal();
+
+    // Lifecycle; open() first cuts off a torn record found by replay(), so
+    // the next record starts on a line of its own
+    bool open(const string& filename);
+    void close();
+    bool truncate();
+    size_t size() const;
+
+    // Appending
+    bool logAllocate(const string& studentId, const string& roomNumber);
+    bool logDeallocate(const string& studentId);
+    bool logStudent(const string& key, const Student& student);
+    bool logRemoveStudent(const string& studentId);
+    bool logRoom(const string& key, const Room& room);
+    bool logRemoveRoom(const string& roomNumber);
+    // Steps are (student ID, room number); no room number means deallocate
+    bool logTransaction(const vector<pair<string, string>>& steps);
+
+    // Replay: the handler receives op, key and the remaining payload fields.
+    // A last record without its newline was cut short by a crash and is
+    // skipped. Returns the number of records replayed.
+    size_t replay(const string& filename,
+                  const function<void(const string&, const string&,
+                                      const vector<string>&)>& apply);
+};
+
+#endif // JOURNAL_H
@@ -0,0 +1,137 @@
+#include "Keys.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+
+const uint64_t Keys::NONE;
+const uint64_t Keys::INTERNED;
+
+namespace {
+    const size_t STUDENT_ID_DIGITS = 13;
+    const size_t MAX_ROOM_DIGITS = 18;
+
+    // Strings that do not fit the numeric encoding; deque keeps the
+    // map's string_view keys valid as it grows
+    class InternTable {
+    private:
+        mutable mutex lock;
+        deque<string> names;
+        unordered_map<string_view, uint64_t> codes;
+
+    public:
+        uint64_t intern(string_view value) {
+            lock_guard<mutex> guard(lock);
+            auto it = codes.find(value);
+            if (it != codes.end()) return it->second;
+            uint64_t key = Keys::INTERNED | names.size();
+            names.emplace_back(value);
+            codes.emplace(string_view(names.back()), key);
+            return key;
+        }
+
+        uint64_t find(string_view value) const {
+            lock_guard<mutex> guard(lock);
+            auto it = codes.find(value);
+            return (it != codes.end()) ? it->second : Keys::NONE;
+        }
+
+        void append(string& out, uint64_t key) const {
+            lock_guard<mutex> guard(lock);
+            size_t index = static_cast<size_t>(key & ~Keys::INTERNED);
+            if (index < names.size()) out += names[index];
+        }
+    };
+
+    InternTable& studentTable() {
+        static InternTable table;
+        return table;
+    }
+
+    InternTable& roomTable() {
+        static InternTable table;
+        return table;
+    }
+
+    bool allDigits(string_view s) {
+        for (char c : s) {
+            if (c < '0' || c > '9') return false;
+        }
+        return true;
+    }
+
+    uint64_t digitsValue(string_view s) {
+        uint64_t value = 0;
+        for (char c : s) value = value * 10 + static_cast<uint64_t>(c - '0');
+        return value;
+    }
+
+    bool numericStudent(string_view id) {
+        return id.size() == STUDENT_ID_DIGITS && allDigits(id);
+    }
+
+    bool numericRoom(string_view number) {
+        return !number.empty() && number.size() <= MAX_ROOM_DIGITS && allDigits(number) &&
+               (number[0] != '0' || number.size() == 1);
+    }
+
+    void appendDigits(string& out, uint64_t value, size_t width) {
+        char buffer[24];
+        size_t n = 0;
+        do {
+            buffer[n++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (n < width) buffer[n++] = '0';
+        while (n > 0) out += buffer[--n];
+    }
+}
+
+StudentKey Keys::student(string_view id) {
+    if (id.empty()) return NONE;
+    if (numericStudent(id)) return digitsValue(id);
+    return studentTable().intern(id);
+}
+
+RoomKey Keys::room(string_view number) {
+    if (number.empty()) return NONE;
+    if (numericRoom(number)) return digitsValue(number);
+    return roomTable().intern(number);
+}
+
+StudentKey Keys::findStudent(string_view id) {
+    if (id.empty()) return NONE;
+    if (numericStudent(id)) return digitsValue(id);
+    return studentTable().find(id);
+}
+
+RoomKey Keys::findRoom(string_view number) {
+    if (number.empty()) return NONE;
+    if (numericRoom(number)) return digitsValue(number);
+    return roomTable().find(number);
+}
+
+void Keys::appendStudentId(string& out, StudentKey key) {
+    if (key == NONE) return;
+    if (key & INTERNED) studentTable().append(out, key);
+    else appendDigits(out, key, STUDENT_ID_DIGITS);
+}
+
+void Keys::appendRoomNumber(string& out, RoomKey key) {
+    if (key == NONE) return;
+    if (key & INTERNED) roomTable().append(out, key);
+    else appendDigits(out, key, 1);
+}
+
+string Keys::studentId(StudentKey key) {
+    string out;
+    appendStudentId(out, key);
+    return out;
+}
+
+string Keys::roomNumber(RoomKey key) {
+    string out;
+    appendRoomNumber(out, key);
+    return out;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file Keys.h
+ * @brief Integer Keys for Student IDs and Room Numbers
+ *
+ * Student IDs and room numbers are kept and compared as 64-bit keys;
+ * strings are produced only when a record is printed, saved or journaled.
+ *
+ * Encoding:
+ * - A student ID of exactly 13 digits is its decimal value (printed back
+ *   zero-padded to 13 digits)
+ * - A room number of 1-18 digits without a leading zero is its value
+ * - Anything else is interned: the key is INTERNED | index into a
+ *   process-wide table of the original strings, so every ID still
+ *   round-trips exactly
+ * - An empty string (no roommate, no room) is NONE
+ *
+ * Interning is thread-safe, so records can be parsed on worker threads.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef KEYS_H
+#define KEYS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+typedef uint64_t StudentKey;
+typedef uint64_t RoomKey;
+
+class Keys {
+public:
+    static const uint64_t NONE = ~0ULL;
+    static const uint64_t INTERNED = 1ULL << 63;
+
+    // String -> key, interning IDs that are not plain numbers
+    static StudentKey student(string_view id);
+    static RoomKey room(string_view number);
+
+    // String -> key without interning: NONE for an ID that no record has
+    // ever used (lookups of user input go through these)
+    static StudentKey findStudent(string_view id);
+    static RoomKey findRoom(string_view number);
+
+    // Key -> string; NONE gives ""
+    static string studentId(StudentKey key);
+    static string roomNumber(RoomKey key);
+    static void appendStudentId(string& out, StudentKey key);
+    static void appendRoomNumber(string& out, RoomKey key);
+};
+
+#endif // KEYS_H
@@ -0,0 +1,25 @@
+#include "LoadArena.h"
+
+using namespace std;
+
+LoadArena::LoadArena() : enabled(true) {}
+
+void LoadArena::setEnabled(bool on) {
+    enabled = on;
+}
+
+bool LoadArena::isEnabled() const {
+    return enabled;
+}
+
+pmr::memory_resource* LoadArena::region() {
+    if (!enabled) return pmr::new_delete_resource();
+    lock_guard<mutex> guard(regionsLock);
+    regions.emplace_back(new pmr::monotonic_buffer_resource(INITIAL_REGION_BYTES));
+    return regions.back().get();
+}
+
+void LoadArena::release() {
+    lock_guard<mutex> guard(regionsLock);
+    regions.clear();
+}
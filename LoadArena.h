@@ -0,0 +1,58 @@
+/**
+ * @file LoadArena.h
+ * @brief Bulk Storage for the String and List Payloads of Loaded Records
+ *
+ * Student and Room keep their strings and key lists in std::pmr
+ * containers. Records built by the loaders take their memory from a
+ * LoadArena region (a monotonic buffer) instead of one heap allocation
+ * per long string or list, and the whole load is given back in one step
+ * when the data is reloaded or the manager goes away.
+ *
+ * Each loader thread asks for its own region, since a monotonic buffer
+ * is not thread-safe. Memory freed by a record inside a region is only
+ * reclaimed with the region, so edits to loaded records (which copy into
+ * the record's own region) grow it until the next release. Records
+ * created later, or copied, use the ordinary heap.
+ *
+ * With the arena disabled, region() hands out the heap and the loaders
+ * behave exactly as before.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef LOADARENA_H
+#define LOADARENA_H
+
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+class LoadArena {
+private:
+    bool enabled;
+    mutex regionsLock;
+    vector<unique_ptr<pmr::monotonic_buffer_resource>> regions;
+
+public:
+    // First block of each region; later blocks grow geometrically
+    static const size_t INITIAL_REGION_BYTES = 64 * 1024;
+
+    LoadArena();
+    LoadArena(const LoadArena&) = delete;
+    LoadArena& operator=(const LoadArena&) = delete;
+
+    void setEnabled(bool on);
+    bool isEnabled() const;
+
+    // A fresh region for one loader thread (the heap when disabled)
+    pmr::memory_resource* region();
+    // Frees every region at once; no record placed in them may remain
+    void release();
+};
+
+#endif // LOADARENA_H
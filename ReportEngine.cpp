@@ -0,0 +1,236 @@
+#include "ReportEngine.h"
+#include "DataVersions.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <string_view>
+
+using namespace std;
+
+namespace {
+    // Below this many rows per worker a thread costs more than it saves
+    const size_t MIN_ROWS_PER_THREAD = 65536;
+    // Years 0..DENSE_YEARS-1 are counted in an array, others in a map
+    const int DENSE_YEARS = 16;
+
+    // Rooms of a version are tallied by name (views into its records)
+    typedef unordered_map<string_view, ReportSummary::Tally> NamedTallies;
+
+    // One worker's counts; merged in worker order
+    struct Partial {
+        int allocatedStudents = 0;
+        int occupiedRooms = 0;
+        int totalCapacity = 0;
+        int totalOccupancy = 0;
+        vector<ReportSummary::Tally> byType, byBlock, byFloor, byRent;
+        unordered_map<string_view, int> byCourse; // views into the student records
+        vector<int> byYear;
+        unordered_map<int, int> otherYears;
+        NamedTallies typeNames, blockNames, floorNames;
+    };
+
+    void addTally(ReportSummary::Tally& into, const ReportSummary::Tally& from) {
+        into.rooms += from.rooms;
+        into.capacity += from.capacity;
+        into.occupancy += from.occupancy;
+    }
+
+    size_t rentBand(double rent) {
+        const double top = static_cast<double>(ReportEngine::MAX_RENT_BANDS - 1) * ReportEngine::RENT_STEP;
+        if (!(rent > 0)) return 0;
+        if (rent >= top) return ReportEngine::MAX_RENT_BANDS - 1;
+        return static_cast<size_t>(rent / ReportEngine::RENT_STEP);
+    }
+
+    // Named groups from code-indexed tallies, sorted by name
+    vector<pair<string, ReportSummary::Tally>> namedGroups(const vector<ReportSummary::Tally>& tallies,
+                                                           const StringPool& names) {
+        vector<pair<string, ReportSummary::Tally>> groups;
+        for (size_t code = 0; code < tallies.size(); ++code) {
+            if (tallies[code].rooms == 0) continue;
+            groups.emplace_back(names.name(static_cast<uint32_t>(code)), tallies[code]);
+        }
+        sort(groups.begin(), groups.end(),
+             [](const pair<string, ReportSummary::Tally>& a, const pair<string, ReportSummary::Tally>& b) {
+                 return a.first < b.first;
+             });
+        return groups;
+    }
+
+    vector<pair<string, ReportSummary::Tally>> namedGroups(const NamedTallies& tallies) {
+        vector<pair<string, ReportSummary::Tally>> groups;
+        for (const auto& group : tallies) groups.emplace_back(string(group.first), group.second);
+        sort(groups.begin(), groups.end(),
+             [](const pair<string, ReportSummary::Tally>& a, const pair<string, ReportSummary::Tally>& b) {
+                 return a.first < b.first;
+             });
+        return groups;
+    }
+
+    void addNamed(NamedTallies& into, const NamedTallies& from) {
+        for (const auto& group : from) addTally(into[group.first], group.second);
+    }
+
+    // Adds every later partial into the first
+    Partial mergePartials(vector<Partial>& partials) {
+        Partial merged = move(partials[0]);
+        for (size_t w = 1; w < partials.size(); ++w) {
+            const Partial& part = partials[w];
+            merged.allocatedStudents += part.allocatedStudents;
+            merged.occupiedRooms += part.occupiedRooms;
+            merged.totalCapacity += part.totalCapacity;
+            merged.totalOccupancy += part.totalOccupancy;
+            for (size_t c = 0; c < part.byType.size(); ++c) addTally(merged.byType[c], part.byType[c]);
+            for (size_t c = 0; c < part.byBlock.size(); ++c) addTally(merged.byBlock[c], part.byBlock[c]);
+            for (size_t c = 0; c < part.byFloor.size(); ++c) addTally(merged.byFloor[c], part.byFloor[c]);
+            for (size_t b = 0; b < part.byRent.size(); ++b) addTally(merged.byRent[b], part.byRent[b]);
+            addNamed(merged.typeNames, part.typeNames);
+            addNamed(merged.blockNames, part.blockNames);
+            addNamed(merged.floorNames, part.floorNames);
+            for (const auto& course : part.byCourse) merged.byCourse[course.first] += course.second;
+            for (int y = 0; y < DENSE_YEARS; ++y) merged.byYear[y] += part.byYear[y];
+            for (const auto& year : part.otherYears) merged.otherYears[year.first] += year.second;
+        }
+        return merged;
+    }
+
+    // Totals, rent bands, courses and years; the room groups are left to
+    // the caller
+    void fillSummary(ReportSummary& summary, const Partial& merged) {
+        summary.allocatedStudents = merged.allocatedStudents;
+        summary.occupiedRooms = merged.occupiedRooms;
+        summary.totalCapacity = merged.totalCapacity;
+        summary.totalOccupancy = merged.totalOccupancy;
+        for (size_t b = 0; b < merged.byRent.size(); ++b) {
+            if (merged.byRent[b].rooms == 0) continue;
+            summary.byRent.emplace_back(static_cast<int>(b) * ReportEngine::RENT_STEP, merged.byRent[b]);
+        }
+
+        for (const auto& course : merged.byCourse) summary.byCourse.emplace_back(string(course.first), course.second);
+        sort(summary.byCourse.begin(), summary.byCourse.end());
+        for (int y = 0; y < DENSE_YEARS; ++y) {
+            if (merged.byYear[y] > 0) summary.byYear.emplace_back(y, merged.byYear[y]);
+        }
+        for (const auto& year : merged.otherYears) summary.byYear.push_back(year);
+        sort(summary.byYear.begin(), summary.byYear.end());
+    }
+
+    size_t pickThreads(size_t threads, size_t rows) {
+        if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+        return max<size_t>(1, min(threads, rows / MIN_ROWS_PER_THREAD));
+    }
+
+    void runWorkers(size_t threads, const function<void(size_t)>& work) {
+        vector<thread> workers;
+        for (size_t w = 1; w < threads; ++w) workers.emplace_back(work, w);
+        work(0);
+        for (auto& worker : workers) worker.join();
+    }
+
+    void countRoom(Partial& out, const ReportSummary::Tally& room) {
+        out.totalCapacity += room.capacity;
+        out.totalOccupancy += room.occupancy;
+        out.occupiedRooms += (room.occupancy != 0);
+    }
+}
+
+// Aggregation
+template <typename Partial, typename Students>
+Partial ReportEngine::countAll(const Students& students, size_t roomCount, size_t threads,
+                               const function<void(Partial&, size_t, size_t)>& countRooms) {
+    threads = pickThreads(threads, max(students.size(), roomCount));
+    vector<Partial> partials(threads);
+    runWorkers(threads, [&](size_t w) {
+        Partial& out = partials[w];
+        out.byYear.assign(DENSE_YEARS, 0);
+        for (size_t i = students.size() * w / threads, last = students.size() * (w + 1) / threads;
+             i < last; ++i) {
+            const Student& student = students[i];
+            out.allocatedStudents += student.isAllocated ? 1 : 0;
+            out.byCourse[string_view(student.course)]++;
+            if (student.year >= 0 && student.year < DENSE_YEARS) out.byYear[student.year]++;
+            else out.otherYears[student.year]++;
+        }
+        countRooms(out, roomCount * w / threads, roomCount * (w + 1) / threads);
+    });
+    return mergePartials(partials);
+}
+
+ReportSummary ReportEngine::compute(const vector<Student>& students, const RoomTable& rooms,
+                                    size_t threads) {
+    size_t roomCount = rooms.size();
+
+    // Rent bands are dense up to the highest rent
+    const double* rent = rooms.rent();
+    size_t bands = 1;
+    for (size_t i = 0; i < roomCount; ++i) bands = max(bands, rentBand(rent[i]) + 1);
+
+    const int32_t* capacity = rooms.capacity();
+    const int32_t* occupancy = rooms.occupancy();
+    const uint32_t* type = rooms.type();
+    const uint32_t* block = rooms.block();
+    const uint32_t* floor = rooms.floor();
+    auto countRooms = [&](Partial& out, size_t first, size_t last) {
+        // Room columns
+        out.byType.assign(rooms.types().size(), ReportSummary::Tally());
+        out.byBlock.assign(rooms.blocks().size(), ReportSummary::Tally());
+        out.byFloor.assign(rooms.floors().size(), ReportSummary::Tally());
+        out.byRent.assign(bands, ReportSummary::Tally());
+        for (size_t i = first; i < last; ++i) {
+            ReportSummary::Tally room;
+            room.rooms = 1;
+            room.capacity = capacity[i];
+            room.occupancy = occupancy[i];
+            countRoom(out, room);
+            addTally(out.byType[type[i]], room);
+            addTally(out.byBlock[block[i]], room);
+            addTally(out.byFloor[floor[i]], room);
+            addTally(out.byRent[rentBand(rent[i])], room);
+        }
+    };
+    Partial merged = countAll<Partial>(students, roomCount, threads, countRooms);
+
+    ReportSummary summary;
+    summary.totalStudents = static_cast<int>(students.size());
+    summary.totalRooms = static_cast<int>(roomCount);
+    fillSummary(summary, merged);
+    summary.byType = namedGroups(merged.byType, rooms.types());
+    summary.byBlock = namedGroups(merged.byBlock, rooms.blocks());
+    summary.byFloor = namedGroups(merged.byFloor, rooms.floors());
+    return summary;
+}
+
+ReportSummary ReportEngine::compute(const DataVersion& version, size_t threads) {
+    const VersionedRecords<Room>& rooms = version.rooms;
+    size_t roomCount = rooms.size();
+
+    size_t bands = 1;
+    for (size_t i = 0; i < roomCount; ++i) bands = max(bands, rentBand(rooms[i].getRent()) + 1);
+
+    auto countRooms = [&](Partial& out, size_t first, size_t last) {
+        out.byRent.assign(bands, ReportSummary::Tally());
+        for (size_t i = first; i < last; ++i) {
+            const Room& record = rooms[i];
+            ReportSummary::Tally room;
+            room.rooms = 1;
+            room.capacity = record.getCapacity();
+            room.occupancy = record.getCurrentOccupancy();
+            countRoom(out, room);
+            addTally(out.typeNames[record.getRoomType()], room);
+            addTally(out.blockNames[record.getBlock()], room);
+            addTally(out.floorNames[record.getFloor()], room);
+            addTally(out.byRent[rentBand(record.getRent())], room);
+        }
+    };
+    Partial merged = countAll<Partial>(version.students, roomCount, threads, countRooms);
+
+    ReportSummary summary;
+    summary.totalStudents = static_cast<int>(version.students.size());
+    summary.totalRooms = static_cast<int>(roomCount);
+    fillSummary(summary, merged);
+    summary.byType = namedGroups(merged.typeNames);
+    summary.byBlock = namedGroups(merged.blockNames);
+    summary.byFloor = namedGroups(merged.floorNames);
+    return summary;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file ReportEngine.h
+ * @brief Single-Pass Aggregation for All Reports
+ *
+ * Computes every figure the reports print in one pass over the students
+ * and one over the room table, instead of one walk per report:
+ * - allocation totals (students, rooms, capacity, occupancy)
+ * - rooms per type, block, floor and rent band
+ * - students per course and year
+ *
+ * Rows are split into one range per worker. Each worker counts into
+ * dense arrays indexed by the room table's interned type/block/floor
+ * codes, by rent band and by year; courses are counted per distinct
+ * string. The partial counts are merged at the end, and the resulting
+ * lists are sorted by name (or value) for printing.
+ *
+ * The same figures can be taken from a pinned DataVersion. Its rooms are
+ * grouped by name rather than by table code, since the table follows the
+ * live rooms while the version may be older.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef REPORTENGINE_H
+#define REPORTENGINE_H
+
+#include "Student.h"
+#include "RoomTable.h"
+#include <vector>
+#include <string>
+#include <utility>
+#include <functional>
+
+using namespace std;
+
+struct DataVersion;
+
+struct ReportSummary {
+    struct Tally {
+        int rooms = 0;
+        int capacity = 0;
+        int occupancy = 0;
+    };
+
+    int totalStudents = 0;
+    int allocatedStudents = 0;
+    int totalRooms = 0;
+    int occupiedRooms = 0;
+    int totalCapacity = 0;
+    int totalOccupancy = 0;
+
+    // Sorted by name; empty groups are left out
+    vector<pair<string, Tally>> byType;
+    vector<pair<string, Tally>> byBlock;
+    vector<pair<string, Tally>> byFloor;
+    // Keyed by the lowest rent of the band, ascending
+    vector<pair<int, Tally>> byRent;
+    vector<pair<string, int>> byCourse;
+    vector<pair<int, int>> byYear;
+};
+
+class ReportEngine {
+public:
+    // Width of a rent band in the breakdown report; the last band is
+    // open-ended so a stray rent cannot blow up the band array
+    static const int RENT_STEP = 1000;
+    static const int MAX_RENT_BANDS = 1000;
+
+    // Aggregates everything in one pass; threads = 0 picks one per core
+    // (small inputs always run on the calling thread)
+    static ReportSummary compute(const vector<Student>& students, const RoomTable& rooms,
+                                 size_t threads);
+    // The same from a pinned version; needs no lock on the live records
+    static ReportSummary compute(const DataVersion& version, size_t threads);
+
+private:
+    // The pass both overloads share: workers count their share of the
+    // students (a vector or a version's records, read by slot) and hand
+    // their share of room rows [first, last) to countRooms
+    template <typename Partial, typename Students>
+    static Partial countAll(const Students& students, size_t roomCount, size_t threads,
+                            const function<void(Partial&, size_t, size_t)>& countRooms);
+};
+
+#endif // REPORTENGINE_H
@@ -0,0 +1,96 @@
+#include "ReshuffleEngine.h"
+#include "CsvUtils.h"
+#include <iostream>
+#include <unordered_map>
+
+using namespace std;
+
+// Input
+bool ReshuffleEngine::parse(istream& in, vector<Request>& requests) {
+    bool ok = true;
+    string record;
+    size_t row = 0;
+    while (csvReadRecord(in, record)) {
+        row++;
+        size_t first = record.find_first_not_of(" \t\r");
+        if (first == string::npos || record[first] == '#') continue;
+        vector<string> fields = csvParseLine(record);
+        for (auto& field : fields) field = csvTrim(field);
+
+        Request request{false, Keys::NONE, Keys::NONE, Keys::NONE, row};
+        if (fields.size() == 3 && fields[0] == "move") {
+            request.student = Keys::findStudent(fields[1]);
+            request.room = Keys::findRoom(fields[2]);
+        } else if (fields.size() == 3 && fields[0] == "swap") {
+            request.swap = true;
+            request.student = Keys::findStudent(fields[1]);
+            request.other = Keys::findStudent(fields[2]);
+        } else {
+            cout << "Row " << row << ": expected move,STUDENT_ID,ROOM_NUMBER or swap,STUDENT_ID,STUDENT_ID" << endl;
+            ok = false;
+            continue;
+        }
+        // Keys::find* give NONE for an ID no record has ever used
+        string missing;
+        if (request.student == Keys::NONE) missing = "student " + fields[1];
+        else if (request.swap && request.other == Keys::NONE) missing = "student " + fields[2];
+        else if (!request.swap && request.room == Keys::NONE) missing = "room " + fields[2];
+        if (!missing.empty()) {
+            cout << "Row " << row << ": " << missing << " not found" << endl;
+            ok = false;
+            continue;
+        }
+        requests.push_back(request);
+    }
+    return ok;
+}
+
+// Planning
+bool ReshuffleEngine::stage(const vector<Request>& requests, const vector<Student>& students,
+                            const HostelIndex& index, AllocationTransaction& transaction, size_t& moved) {
+    // Target room per student slot, in order of first mention
+    unordered_map<size_t, RoomKey> target;
+    vector<size_t> order;
+    auto targetOf = [&](size_t slot) -> RoomKey& {
+        auto it = target.find(slot);
+        if (it != target.end()) return it->second;
+        order.push_back(slot);
+        return target[slot] = students[slot].getRoomKey();
+    };
+    auto slotOf = [&](StudentKey studentId, size_t row) {
+        size_t slot = index.studentSlot(studentId);
+        if (slot == HostelIndex::npos) {
+            cout << "Row " << row << ": student " << Keys::studentId(studentId) << " not found" << endl;
+        }
+        return slot;
+    };
+
+    for (const Request& request : requests) {
+        size_t slot = slotOf(request.student, request.row);
+        if (slot == HostelIndex::npos) return false;
+        if (request.swap) {
+            size_t other = slotOf(request.other, request.row);
+            if (other == HostelIndex::npos) return false;
+            RoomKey room = targetOf(slot);
+            targetOf(slot) = targetOf(other);
+            targetOf(other) = room;
+        } else {
+            if (!index.hasRoom(request.room)) {
+                cout << "Row " << request.row << ": room " << Keys::roomNumber(request.room) << " not found" << endl;
+                return false;
+            }
+            targetOf(slot) = request.room;
+        }
+    }
+
+    moved = 0;
+    for (size_t slot : order) {
+        const Student& student = students[slot];
+        RoomKey room = target[slot];
+        if (room == student.getRoomKey()) continue;
+        if (student.getIsAllocated()) transaction.stageDeallocate(student.getKey());
+        if (room != Keys::NONE) transaction.stageAllocate(student.getKey(), room);
+        moved++;
+    }
+    return true;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file ReshuffleEngine.h
+ * @brief Batches of Room Moves and Swaps Applied as One Permutation
+ *
+ * A reshuffle is a list of requests, one per CSV row:
+ * - move,STUDENT_ID,ROOM_NUMBER   the student ends up in that room
+ * - swap,STUDENT_ID,STUDENT_ID    the two students exchange rooms
+ * Blank rows and rows starting with '#' are skipped.
+ *
+ * The requests are composed in order into one target room per student (a
+ * swap exchanges the two targets so far, so chains of swaps and moves
+ * compose like permutations). Only the students whose target differs
+ * from their current room are staged, as a deallocate plus an allocate,
+ * on one AllocationTransaction. Its commit checks every room's capacity
+ * once against the net result and frees all departing beds before filling
+ * any, so swaps and longer cycles among full rooms work. Either the whole
+ * batch is applied or nothing is.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef RESHUFFLEENGINE_H
+#define RESHUFFLEENGINE_H
+
+#include "Student.h"
+#include "HostelIndex.h"
+#include "AllocationTransaction.h"
+#include "Keys.h"
+#include <istream>
+#include <vector>
+
+using namespace std;
+
+class ReshuffleEngine {
+public:
+    struct Request {
+        bool swap;            // swap student and other, else move student to room
+        StudentKey student;
+        StudentKey other;     // Keys::NONE for a move
+        RoomKey room;         // Keys::NONE for a swap
+        size_t row;           // 1-based row in the input, for messages
+    };
+
+    // Reads every request; prints each malformed row and returns false if
+    // there was any
+    static bool parse(istream& in, vector<Request>& requests);
+
+    // Stages the net changes on transaction; false (with a message) if a
+    // request names an unknown student or room. moved is the number of
+    // students whose room changes
+    static bool stage(const vector<Request>& requests, const vector<Student>& students,
+                      const HostelIndex& index, AllocationTransaction& transaction, size_t& moved);
+};
+
+#endif // RESHUFFLEENGINE_H
@@ -1,87 +1,62 @@
 #include "Room.h"
+#include "CsvUtils.h"
+#include "CsvReader.h"
 #include <algorithm>
-#include <sstream>
 
 using namespace std;
 
-namespace {
-    static inline string trim(const string& s) {
-        size_t start = s.find_first_not_of(" \t\r\n");
-        if (start == string::npos) return "";
-        size_t end = s.find_last_not_of(" \t\r\n");
-        return s.substr(start, end - start + 1);
-    }
-    string csvEscape(const string& value) {
-        bool needsQuotes = value.find_first_of(",\"\n") != string::npos;
-        string out = value;
-        size_t pos = 0;
-        while ((pos = out.find('"', pos)) != string::npos) {
-            out.insert(pos, 1, '"');
-            pos += 2;
-        }
-        if (needsQuotes) return string("\"") + out + string("\"");
-        return out;
-    }
-    vector<string> csvParseLine(const string& line) {
-        vector<string> result; string cur; bool inQuotes = false;
-        for (size_t i = 0; i < line.size(); ++i) {
-            char c = line[i];
-            if (inQuotes) {
-                if (c == '"') {
-                    if (i + 1 < line.size() && line[i + 1] == '"') {
-                        cur.push_back('"'); ++i;
-                    } else { inQuotes = false; }
-                } else { cur.push_back(c); }
-            } else {
-                if (c == ',') { result.push_back(cur); cur.clear(); }
-                else if (c == '"') { inQuotes = true; }
-                else { cur.push_back(c); }
-            }
-        }
-        result.push_back(cur);
-        for (auto& t : result) t = trim(t);
-        return result;
-    }
-}
-
 // Default constructor
-Room::Room() : roomNumber(""), roomType(""), capacity(0), currentOccupancy(0), 
+Room::Room() : roomNumber(Keys::NONE), roomType(""), capacity(0), currentOccupancy(0), 
                isAvailable(true), rent(0.0), floor(""), block("") {}
 
+// Constructor for loaders: strings and occupants live in memory
+Room::Room(pmr::memory_resource* memory)
+    : roomNumber(Keys::NONE), roomType(memory), capacity(0), currentOccupancy(0),
+      occupants(memory), isAvailable(true), rent(0.0), floor(memory), block(memory) {}
+
 // Parameterized constructor
 Room::Room(const string& roomNo, const string& type, int cap, 
            double rent, const string& floor, const string& block)
-    : roomNumber(roomNo), roomType(type), capacity(cap), currentOccupancy(0), 
+    : roomNumber(Keys::room(roomNo)), roomType(type), capacity(cap), currentOccupancy(0), 
       isAvailable(true), rent(rent), floor(floor), block(block) {}
 
 // Getters
-string Room::getRoomNumber() const { return roomNumber; }
-string Room::getRoomType() const { return roomType; }
+string Room::getRoomNumber() const { return Keys::roomNumber(roomNumber); }
+string_view Room::getRoomType() const { return roomType; }
 int Room::getCapacity() const { return capacity; }
 int Room::getCurrentOccupancy() const { return currentOccupancy; }
-vector<string> Room::getOccupants() const { return occupants; }
 bool Room::getIsAvailable() const { return isAvailable; }
 double Room::getRent() const { return rent; }
-string Room::getFloor() const { return floor; }
-string Room::getBlock() const { return block; }
+string_view Room::getFloor() const { return floor; }
+string_view Room::getBlock() const { return block; }
 
 int Room::getAvailableSlots() const {
     return capacity - currentOccupancy;
 }
 
+vector<string> Room::getOccupants() const {
+    vector<string> ids;
+    ids.reserve(occupants.size());
+    for (StudentKey occupant : occupants) ids.push_back(Keys::studentId(occupant));
+    return ids;
+}
+
+RoomKey Room::getKey() const { return roomNumber; }
+const pmr::vector<StudentKey>& Room::getOccupantKeys() const { return occupants; }
+
 // Setters
-void Room::setRoomNumber(const string& roomNo) { roomNumber = roomNo; }
-void Room::setRoomType(const string& type) { roomType = type; }
+void Room::setRoomNumber(const string& roomNo) { roomNumber = Keys::room(roomNo); }
+void Room::setRoomType(const string& type) { roomType.assign(type); }
 void Room::setCapacity(int cap) { 
     capacity = cap; 
     updateAvailability();
 }
 void Room::setRent(double rent) { this->rent = rent; }
-void Room::setFloor(const string& floor) { this->floor = floor; }
-void Room::setBlock(const string& block) { this->block = block; }
+void Room::setFloor(const string& floor) { this->floor.assign(floor); }
+void Room::setBlock(const string& block) { this->block.assign(block); }
 
 // Add occupant to room
-bool Room::addOccupant(const string& studentId) {
+bool Room::addOccupant(StudentKey studentId) {
     if (isFull()) {
         return false;
     }
@@ -98,7 +73,7 @@ bool Room::addOccupant(const string& studentId) {
 }
 
 // Remove occupant from room
-bool Room::removeOccupant(const string& studentId) {
+bool Room::removeOccupant(StudentKey studentId) {
     auto it = find(occupants.begin(), occupants.end(), studentId);
     if (it != occupants.end()) {
         occupants.erase(it);
@@ -125,25 +100,25 @@ void Room::updateAvailability() {
 }
 
 // Display room information
-void Room::displayInfo() const {
-    cout << "\n=== Room Information ===" << endl;
-    cout << "Room Number: " << roomNumber << endl;
-    cout << "Room Type: " << roomType << endl;
-    cout << "Capacity: " << capacity << endl;
-    cout << "Current Occupancy: " << currentOccupancy << endl;
-    cout << "Available Slots: " << getAvailableSlots() << endl;
-    cout << "Rent: $" << rent << endl;
-    cout << "Floor: " << floor << endl;
-    cout << "Block: " << block << endl;
-    cout << "Status: " << (isAvailable ? "Available" : "Full") << endl;
+void Room::displayInfo(ostream& out) const {
+    out << "\n=== Room Information ===" << endl;
+    out << "Room Number: " << getRoomNumber() << endl;
+    out << "Room Type: " << roomType << endl;
+    out << "Capacity: " << capacity << endl;
+    out << "Current Occupancy: " << currentOccupancy << endl;
+    out << "Available Slots: " << getAvailableSlots() << endl;
+    out << "Rent: $" << rent << endl;
+    out << "Floor: " << floor << endl;
+    out << "Block: " << block << endl;
+    out << "Status: " << (isAvailable ? "Available" : "Full") << endl;
     
     if (!occupants.empty()) {
-        cout << "Occupants: ";
+        out << "Occupants: ";
         for (size_t i = 0; i < occupants.size(); ++i) {
-            cout << occupants[i];
-            if (i < occupants.size() - 1) cout << ", ";
+            out << Keys::studentId(occupants[i]);
+            if (i < occupants.size() - 1) out << ", ";
         }
-        cout << endl;
+        out << endl;
     }
 }
 
@@ -151,8 +126,10 @@ void Room::displayInfo() const {
 void Room::inputDetails() {
     cout << "\n=== Enter Room Details ===" << endl;
     
+    string input;
     cout << "Enter Room Number: ";
-    getline(cin, roomNumber);
+    getline(cin, input);
+    roomNumber = Keys::room(input);
     
     do {
         cout << "Enter Room Type (Single/Double/Triple/Quad): ";
@@ -181,13 +158,14 @@ void Room::inputDetails() {
     cout << "Enter Block: ";
     getline(cin, block);
     
-    currentOccupancy = 0;
+    // A new room has no occupants; an edited one keeps them
+    currentOccupancy = static_cast<int>(occupants.size());
     updateAvailability();
 }
 
 // Validate room type
-bool Room::isValidRoomType(const string& type) const {
-    string lowerType = type;
+bool Room::isValidRoomType(string_view type) const {
+    string lowerType(type);
     transform(lowerType.begin(), lowerType.end(), lowerType.begin(), ::tolower);
     
     return (lowerType == "single" || lowerType == "double" || 
@@ -200,42 +178,49 @@ void Room::saveToFile(ostream& file) const {
     string occ;
     for (size_t i = 0; i < occupants.size(); ++i) {
         if (i) occ += ';';
-        occ += occupants[i];
+        Keys::appendStudentId(occ, occupants[i]);
     }
-    file
-        << csvEscape(roomNumber) << ','
-        << csvEscape(roomType) << ','
-        << capacity << ','
-        << currentOccupancy << ','
-        << rent << ','
-        << csvEscape(floor) << ','
-        << csvEscape(block) << ','
-        << (isAvailable ? 1 : 0) << ','
-        << csvEscape(occ)
-        << '\n';
+    csvWrite(file, getRoomNumber()) << ',';
+    csvWrite(file, roomType) << ',' << capacity << ',' << currentOccupancy << ',' << rent << ',';
+    csvWrite(file, floor) << ',';
+    csvWrite(file, block) << ',' << (isAvailable ? 1 : 0) << ',';
+    csvWrite(file, occ) << '\n';
 }
 
 // Load from CSV (generic istream); returns success
 bool Room::loadFromFile(istream& is) {
     string line;
-    if (!getline(is, line)) return false;
-    vector<string> tokens = csvParseLine(line);
-    if (tokens.size() < 8) return false;
-    roomNumber = tokens[0];
-    roomType = tokens[1];
-    capacity = tokens[2].empty() ? 0 : stoi(tokens[2]);
-    currentOccupancy = tokens[3].empty() ? 0 : stoi(tokens[3]);
-    rent = tokens[4].empty() ? 0.0 : stod(tokens[4]);
-    floor = tokens[5];
-    block = tokens[6];
-    isAvailable = (!tokens[7].empty() && tokens[7] != "0");
+    if (!csvReadRecord(is, line)) return false;
+    return loadFromTokens(csvParseLine(line));
+}
+
+// Load from already-split CSV fields; returns success
+bool Room::loadFromTokens(const vector<string>& tokens) {
+    vector<string_view> fields(tokens.begin(), tokens.end());
+    return loadFromFields(fields);
+}
+
+// Load from string_view fields (zero-copy loaders); one copy per owned field
+bool Room::loadFromFields(const vector<string_view>& fields) {
+    if (fields.size() < 8) return false;
+    roomNumber = Keys::room(fields[0]);
+    roomType.assign(fields[1]);
+    capacity = csvToInt(fields[2]);
+    currentOccupancy = csvToInt(fields[3]);
+    rent = csvToDouble(fields[4]);
+    floor.assign(fields[5]);
+    block.assign(fields[6]);
+    isAvailable = (!fields[7].empty() && fields[7] != "0");
     occupants.clear();
-    if (tokens.size() > 8 && !tokens[8].empty()) {
-        stringstream occStream(tokens[8]);
-        string occupant;
-        while (getline(occStream, occupant, ';')) {
-            occupant = trim(occupant);
-            if (!occupant.empty()) occupants.push_back(occupant);
+    if (fields.size() > 8 && !fields[8].empty()) {
+        // Occupant IDs share one cell, separated by ';'
+        string_view rest = fields[8];
+        while (!rest.empty()) {
+            size_t cut = rest.find(';');
+            string_view occupant = csvTrimView(rest.substr(0, cut));
+            if (!occupant.empty()) occupants.push_back(Keys::student(occupant));
+            if (cut == string_view::npos) break;
+            rest.remove_prefix(cut + 1);
         }
     }
     return true;
@@ -243,22 +228,7 @@ bool Room::loadFromFile(istream& is) {
 
 // Output operator
 ostream& operator<<(ostream& os, const Room& room) {
-    string occ;
-    for (size_t i = 0; i < room.occupants.size(); ++i) {
-        if (i) occ += ';';
-        occ += room.occupants[i];
-    }
-    os
-        << csvEscape(room.roomNumber) << ','
-        << csvEscape(room.roomType) << ','
-        << room.capacity << ','
-        << room.currentOccupancy << ','
-        << room.rent << ','
-        << csvEscape(room.floor) << ','
-        << csvEscape(room.block) << ','
-        << (room.isAvailable ? 1 : 0) << ','
-        << csvEscape(occ)
-        << '\n';
+    room.saveToFile(os);
     return os;
 }
 
@@ -20,8 +20,11 @@
 #ifndef ROOM_H
 #define ROOM_H
 
+#include "Keys.h"
 #include <string>
+#include <string_view>
 #include <vector>
+#include <memory_resource>
 #include <iostream>
 #include <fstream>
 
@@ -29,34 +32,41 @@ using namespace std;
 
 class Room {
 private:
-    string roomNumber;
-    string roomType; // Single, Double, Triple, Quad
+    // Strings and lists are pmr containers so loaders can place them in a
+    // LoadArena region; copies of a record always use the heap
+    RoomKey roomNumber; // integer key, see Keys.h
+    pmr::string roomType; // Single, Double, Triple, Quad
     int capacity;
     int currentOccupancy;
-    vector<string> occupants; // Student IDs
+    pmr::vector<StudentKey> occupants; // Student keys
     bool isAvailable;
     double rent;
-    string floor;
-    string block;
+    pmr::string floor;
+    pmr::string block;
 
 public:
     // Constructors
     Room();
+    explicit Room(pmr::memory_resource* memory);
     Room(const string& roomNo, const string& type, int cap, 
          double rent, const string& floor, const string& block);
     
-    // Getters
+    // Getters (views last as long as the record is unchanged)
     string getRoomNumber() const;
-    string getRoomType() const;
+    string_view getRoomType() const;
     int getCapacity() const;
     int getCurrentOccupancy() const;
     vector<string> getOccupants() const;
     bool getIsAvailable() const;
     double getRent() const;
-    string getFloor() const;
-    string getBlock() const;
+    string_view getFloor() const;
+    string_view getBlock() const;
     int getAvailableSlots() const;
     
+    // Key getters
+    RoomKey getKey() const;
+    const pmr::vector<StudentKey>& getOccupantKeys() const;
+    
     // Setters
     void setRoomNumber(const string& roomNo);
     void setRoomType(const string& type);
@@ -66,20 +76,27 @@ public:
     void setBlock(const string& block);
     
     // Room management functions
-    bool addOccupant(const string& studentId);
-    bool removeOccupant(const string& studentId);
+    bool addOccupant(StudentKey studentId);
+    bool removeOccupant(StudentKey studentId);
     bool isFull() const;
     bool isEmpty() const;
     void updateAvailability();
     
     // Utility functions
-    void displayInfo() const;
+    void displayInfo(ostream& out) const;
     void inputDetails();
-    bool isValidRoomType(const string& type) const;
+    bool isValidRoomType(string_view type) const;
     
     // File operations
     void saveToFile(ostream& os) const;
     bool loadFromFile(istream& is);
+    bool loadFromTokens(const vector<string>& tokens);
+    bool loadFromFields(const vector<string_view>& fields);
+    
+    // Binary snapshots read and write the fields directly
+    friend class Snapshot;
+    // The columnar mirror copies fields without going through the getters
+    friend class RoomTable;
     
     // Friend functions for file operations
     friend ostream& operator<<(ostream& os, const Room& room);
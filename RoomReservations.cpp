@@ -0,0 +1,64 @@
+#include "RoomReservations.h"
+#include <algorithm>
+
+using namespace std;
+
+// Maintenance
+void RoomReservations::grow(size_t minimum) {
+    if (minimum <= allocated) return;
+    size_t target = max<size_t>(minimum, max<size_t>(16, allocated * 2));
+    unique_ptr<atomic<int32_t>[]> larger(new atomic<int32_t>[target]);
+    for (size_t i = 0; i < rows; ++i) {
+        larger[i].store(claimed[i].load(memory_order_relaxed), memory_order_relaxed);
+    }
+    claimed = move(larger);
+    allocated = target;
+}
+
+void RoomReservations::rebuild(const vector<Room>& rooms) {
+    rows = 0;
+    capacity.clear();
+    grow(rooms.size());
+    for (const auto& room : rooms) append(room);
+}
+
+void RoomReservations::append(const Room& room) {
+    grow(rows + 1);
+    claimed[rows].store(room.getCurrentOccupancy(), memory_order_relaxed);
+    capacity.push_back(room.getCapacity());
+    rows++;
+}
+
+void RoomReservations::update(size_t slot, const Room& room) {
+    if (slot >= rows) return;
+    claimed[slot].store(room.getCurrentOccupancy(), memory_order_relaxed);
+    capacity[slot] = room.getCapacity();
+}
+
+// Reservations
+bool RoomReservations::reserve(size_t slot) {
+    if (slot >= rows) return false;
+    atomic<int32_t>& beds = claimed[slot];
+    int32_t current = beds.load(memory_order_relaxed);
+    // A failed exchange reloads current, so the capacity test is repeated
+    // against whatever the winning thread left behind
+    while (current < capacity[slot]) {
+        if (beds.compare_exchange_weak(current, current + 1, memory_order_acq_rel,
+                                       memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RoomReservations::release(size_t slot) {
+    if (slot < rows) claimed[slot].fetch_sub(1, memory_order_acq_rel);
+}
+
+int32_t RoomReservations::claimedBeds(size_t slot) const {
+    return slot < rows ? claimed[slot].load(memory_order_acquire) : 0;
+}
+
+size_t RoomReservations::size() const {
+    return rows;
+}
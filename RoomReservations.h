@@ -0,0 +1,57 @@
+/**
+ * @file RoomReservations.h
+ * @brief Lock-Free Bed Reservations per Room
+ *
+ * One atomic counter per room slot holds the beds claimed in that room:
+ * its occupants plus reservations not yet committed. reserve() raises the
+ * counter with a compare-and-swap only while it is below the capacity, so
+ * any number of threads can race for the last bed of a room and exactly
+ * one wins; no thread ever waits on another. The winner then commits the
+ * occupant (HostelIndex::commitOccupant), which leaves the counter as it
+ * is, or hands the bed back with release().
+ *
+ * The maintenance calls (rebuild/append/update) reset counters from the
+ * committed occupancy and must not overlap reservations; they run where
+ * rooms are loaded, added or edited, which is single-threaded or under the
+ * server's exclusive lock.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ROOMRESERVATIONS_H
+#define ROOMRESERVATIONS_H
+
+#include "Room.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+class RoomReservations {
+private:
+    unique_ptr<atomic<int32_t>[]> claimed; // beds claimed, per room slot
+    vector<int32_t> capacity;
+    size_t rows = 0;
+    size_t allocated = 0;
+
+    void grow(size_t minimum);
+
+public:
+    // Maintenance (no reservations may be in flight)
+    void rebuild(const vector<Room>& rooms);
+    void append(const Room& room);
+    void update(size_t slot, const Room& room);
+
+    // Lock-free; false when every bed of the room is claimed
+    bool reserve(size_t slot);
+    void release(size_t slot);
+
+    int32_t claimedBeds(size_t slot) const;
+    size_t size() const;
+};
+
+#endif // ROOMRESERVATIONS_H
@@ -0,0 +1,148 @@
+#include "RoomTable.h"
+#include <algorithm>
+
+using namespace std;
+
+// StringPool
+uint32_t StringPool::intern(string_view value) {
+    string name(value); // pooled names are short, so this rarely allocates
+    auto it = codes.find(name);
+    if (it != codes.end()) return it->second;
+    uint32_t code = static_cast<uint32_t>(names.size());
+    names.push_back(name);
+    codes.emplace(move(name), code);
+    return code;
+}
+
+const string& StringPool::name(uint32_t code) const {
+    return names[code];
+}
+
+size_t StringPool::size() const {
+    return names.size();
+}
+
+void StringPool::clear() {
+    names.clear();
+    codes.clear();
+}
+
+// Row helpers
+const uint32_t RoomTable::NO_STUDENT;
+
+uint32_t RoomTable::segmentSize(const Room& room) {
+    // Loaded data may list more occupants than the capacity allows
+    return static_cast<uint32_t>(max<size_t>(static_cast<size_t>(max(room.capacity, 0)),
+                                             room.occupants.size()));
+}
+
+void RoomTable::writeRow(size_t slot, const Room& room) {
+    capacityColumn[slot] = room.capacity;
+    occupancyColumn[slot] = room.currentOccupancy;
+    rentColumn[slot] = room.rent;
+    typeColumn[slot] = typeNames.intern(room.roomType);
+    blockColumn[slot] = blockNames.intern(room.block);
+    floorColumn[slot] = floorNames.intern(room.floor);
+}
+
+void RoomTable::writeOccupants(size_t slot, const Room& room, const StudentSlots& students) {
+    uint32_t* segment = occupantSlots.data() + occupantOffset[slot];
+    for (size_t i = 0; i < room.occupants.size(); ++i) {
+        auto it = students.find(room.occupants[i]);
+        segment[i] = (it != students.end()) ? static_cast<uint32_t>(it->second) : NO_STUDENT;
+    }
+    occupantCount[slot] = static_cast<uint32_t>(room.occupants.size());
+}
+
+// Maintenance
+void RoomTable::rebuild(const vector<Room>& rooms) {
+    size_t rows = rooms.size();
+    capacityColumn.assign(rows, 0);
+    occupancyColumn.assign(rows, 0);
+    rentColumn.assign(rows, 0.0);
+    typeColumn.assign(rows, 0);
+    blockColumn.assign(rows, 0);
+    floorColumn.assign(rows, 0);
+    occupantCount.assign(rows, 0);
+    occupantOffset.assign(rows + 1, 0);
+    for (size_t i = 0; i < rows; ++i) {
+        occupantOffset[i + 1] = occupantOffset[i] + segmentSize(rooms[i]);
+    }
+    occupantSlots.assign(occupantOffset[rows], NO_STUDENT);
+    for (size_t i = 0; i < rows; ++i) {
+        writeRow(i, rooms[i]);
+        occupantCount[i] = static_cast<uint32_t>(rooms[i].occupants.size());
+    }
+}
+
+void RoomTable::append(const Room& room, const StudentSlots& students) {
+    size_t slot = capacityColumn.size();
+    capacityColumn.push_back(0);
+    occupancyColumn.push_back(0);
+    rentColumn.push_back(0.0);
+    typeColumn.push_back(0);
+    blockColumn.push_back(0);
+    floorColumn.push_back(0);
+    occupantCount.push_back(0);
+    if (occupantOffset.empty()) occupantOffset.push_back(0);
+    occupantOffset.push_back(occupantOffset.back() + segmentSize(room));
+    occupantSlots.resize(occupantOffset.back(), NO_STUDENT);
+    writeRow(slot, room);
+    writeOccupants(slot, room, students);
+}
+
+void RoomTable::update(const vector<Room>& rooms, size_t slot, const StudentSlots& students) {
+    if (slot >= rooms.size() || slot >= capacityColumn.size()) return;
+    if (segmentSize(rooms[slot]) > occupantOffset[slot + 1] - occupantOffset[slot]) {
+        rebuild(rooms);
+        resolveOccupants(rooms, students);
+        return;
+    }
+    writeRow(slot, rooms[slot]);
+    writeOccupants(slot, rooms[slot], students);
+}
+
+void RoomTable::updateOccupants(const vector<Room>& rooms, size_t slot,
+                                const StudentSlots& students) {
+    if (slot >= rooms.size() || slot >= capacityColumn.size()) return;
+    if (segmentSize(rooms[slot]) > occupantOffset[slot + 1] - occupantOffset[slot]) {
+        rebuild(rooms);
+        resolveOccupants(rooms, students);
+        return;
+    }
+    occupancyColumn[slot] = rooms[slot].currentOccupancy;
+    writeOccupants(slot, rooms[slot], students);
+}
+
+void RoomTable::resolveOccupants(const vector<Room>& rooms, const StudentSlots& students) {
+    size_t rows = min(rooms.size(), capacityColumn.size());
+    for (size_t i = 0; i < rows; ++i) {
+        if (!rooms[i].occupants.empty()) writeOccupants(i, rooms[i], students);
+    }
+}
+
+void RoomTable::studentErased(size_t studentSlot) {
+    // Later students moved down one slot
+    uint32_t erased = static_cast<uint32_t>(studentSlot);
+    for (auto& occupant : occupantSlots) {
+        if (occupant == NO_STUDENT || occupant < erased) continue;
+        occupant = (occupant == erased) ? NO_STUDENT : occupant - 1;
+    }
+}
+
+// Access
+size_t RoomTable::size() const { return capacityColumn.size(); }
+const int32_t* RoomTable::capacity() const { return capacityColumn.data(); }
+const int32_t* RoomTable::occupancy() const { return occupancyColumn.data(); }
+const double* RoomTable::rent() const { return rentColumn.data(); }
+const uint32_t* RoomTable::type() const { return typeColumn.data(); }
+const uint32_t* RoomTable::block() const { return blockColumn.data(); }
+const uint32_t* RoomTable::floor() const { return floorColumn.data(); }
+const StringPool& RoomTable::types() const { return typeNames; }
+const StringPool& RoomTable::blocks() const { return blockNames; }
+const StringPool& RoomTable::floors() const { return floorNames; }
+
+size_t RoomTable::occupantsOf(size_t slot, const uint32_t*& first) const {
+    first = occupantSlots.data() + occupantOffset[slot];
+    return occupantCount[slot];
+}
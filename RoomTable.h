@@ -0,0 +1,107 @@
+/**
+ * @file RoomTable.h
+ * @brief Columnar Mirror of the Room Vector
+ *
+ * Room objects carry four strings and an occupant vector, so a scan that
+ * only needs capacity and occupancy drags all of them through the cache.
+ * RoomTable keeps the hot fields of every room in separate arrays, one
+ * row per room slot:
+ * - capacity, occupancy (int32) and rent (double)
+ * - type, block and floor as small integer codes into interned names
+ * - occupants as student slots in one flat array; room r owns
+ *   occupantSlots[occupantOffset[r] .. occupantOffset[r + 1]), of which
+ *   the first occupantCount[r] entries are used. IDs with no matching
+ *   student are stored as NO_STUDENT.
+ *
+ * The vector<Room> stays the record of truth; HostelIndex refreshes the
+ * matching row whenever it is told a room changed (and the occupant slots
+ * whenever students move), so report and allocation scans can run over
+ * the columns instead.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ROOMTABLE_H
+#define ROOMTABLE_H
+
+#include "Room.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+// Interned strings: each distinct value gets a dense uint32 code
+class StringPool {
+private:
+    vector<string> names;
+    unordered_map<string, uint32_t> codes;
+
+public:
+    uint32_t intern(string_view value);
+    const string& name(uint32_t code) const;
+    size_t size() const;
+    void clear();
+};
+
+// Student key -> slot, as kept by HostelIndex
+typedef unordered_map<StudentKey, size_t> StudentSlots;
+
+class RoomTable {
+private:
+    vector<int32_t> capacityColumn;
+    vector<int32_t> occupancyColumn;
+    vector<double> rentColumn;
+    vector<uint32_t> typeColumn;
+    vector<uint32_t> blockColumn;
+    vector<uint32_t> floorColumn;
+    vector<uint32_t> occupantOffset;   // rows + 1 entries
+    vector<uint32_t> occupantCount;
+    vector<uint32_t> occupantSlots;    // student slots
+    StringPool typeNames;
+    StringPool blockNames;
+    StringPool floorNames;
+
+    void writeRow(size_t slot, const Room& room);
+    void writeOccupants(size_t slot, const Room& room, const StudentSlots& students);
+    static uint32_t segmentSize(const Room& room);
+
+public:
+    static const uint32_t NO_STUDENT = 0xFFFFFFFFu;
+
+    // Whole-table rebuild (after load, reordering or erase); occupants stay
+    // NO_STUDENT until resolveOccupants() runs, so this never reads the
+    // student map
+    void rebuild(const vector<Room>& rooms);
+    // Row maintenance; the occupant array is relaid out only when a room
+    // outgrows its segment
+    void append(const Room& room, const StudentSlots& students);
+    void update(const vector<Room>& rooms, size_t slot, const StudentSlots& students);
+    void updateOccupants(const vector<Room>& rooms, size_t slot, const StudentSlots& students);
+    // Student slots changed under the occupant array
+    void resolveOccupants(const vector<Room>& rooms, const StudentSlots& students);
+    void studentErased(size_t studentSlot);
+
+    size_t size() const;
+
+    // Columns, indexed by room slot
+    const int32_t* capacity() const;
+    const int32_t* occupancy() const;
+    const double* rent() const;
+    const uint32_t* type() const;
+    const uint32_t* block() const;
+    const uint32_t* floor() const;
+
+    // Code -> name dictionaries
+    const StringPool& types() const;
+    const StringPool& blocks() const;
+    const StringPool& floors() const;
+
+    // Occupants of one room, as student slots
+    size_t occupantsOf(size_t slot, const uint32_t*& first) const;
+};
+
+#endif // ROOMTABLE_H
@@ -0,0 +1,151 @@
+#include "RoommateGrouper.h"
+#include <algorithm>
+
+using namespace std;
+
+vector<vector<size_t>> RoommateGrouper::group(const vector<Student>& students, const HostelIndex& index,
+                                              size_t maxGroup) {
+    vector<vector<size_t>> groups;
+    if (maxGroup > MAX_GROUP) maxGroup = MAX_GROUP;
+    if (maxGroup < 2) return groups;
+
+    // One edge per student whose preferred roommate is also waiting for a room
+    const size_t none = HostelIndex::npos;
+    size_t count = students.size();
+    vector<size_t> partner(count, none);
+    vector<size_t> adjStart(count + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        if (students[i].getIsAllocated() || students[i].getRoommateKey() == Keys::NONE) continue;
+        size_t j = index.studentSlot(students[i].getRoommateKey());
+        if (j == none || j == i || students[j].getIsAllocated()) continue;
+        partner[i] = j;
+        adjStart[i + 1]++;
+        adjStart[j + 1]++;
+    }
+    for (size_t i = 0; i < count; ++i) adjStart[i + 1] += adjStart[i];
+    vector<size_t> adjacent(adjStart[count]);
+    vector<size_t> fill(adjStart.begin(), adjStart.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        if (partner[i] == none) continue;
+        adjacent[fill[i]++] = partner[i];
+        adjacent[fill[partner[i]]++] = i;
+    }
+    auto mutual = [&partner, none](size_t u) {
+        size_t v = partner[u];
+        return (v != none && partner[v] == u) ? v : none;
+    };
+
+    // Breadth-first walk per component, taking a mutual partner right
+    // after the student who named them
+    vector<uint8_t> visited(count, 0);
+    vector<uint8_t> onWalk(count, 0);
+    vector<vector<size_t>> pending; // per student slot, while cutting a component
+    vector<size_t> order;
+    vector<size_t> queue;
+    auto visit = [&](size_t u) {
+        visited[u] = 1;
+        order.push_back(u);
+        queue.push_back(u);
+        size_t m = mutual(u);
+        if (m != none && !visited[m]) {
+            visited[m] = 1;
+            order.push_back(m);
+            queue.push_back(m);
+        }
+    };
+    for (size_t first = 0; first < count; ++first) {
+        if (visited[first] || adjStart[first] == adjStart[first + 1]) continue;
+        order.clear();
+        queue.clear();
+        visit(first);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            size_t u = queue[head];
+            for (size_t k = adjStart[u]; k < adjStart[u + 1]; ++k) {
+                if (!visited[adjacent[k]]) visit(adjacent[k]);
+            }
+        }
+        if (order.size() <= maxGroup) {
+            groups.push_back(order);
+            continue;
+        }
+
+        // Too big for one room: each student names at most one other, so
+        // the component is a tree hanging off one root (the end of the
+        // chain, or a student on its cycle, with the cycle's closing link
+        // dropped). Cut it leaves first into room-sized pieces that stay
+        // connected through named roommates; a piece of one is left to
+        // the general allocation
+        size_t root = first;
+        while (partner[root] != none && !onWalk[root]) {
+            onWalk[root] = 1;
+            root = partner[root];
+        }
+        for (size_t u = first; onWalk[u]; u = partner[u]) onWalk[u] = 0;
+
+        // Parents before children
+        order.assign(1, root);
+        visited[root] = 2;
+        for (size_t head = 0; head < order.size(); ++head) {
+            size_t v = order[head];
+            for (size_t k = adjStart[v]; k < adjStart[v + 1]; ++k) {
+                size_t u = adjacent[k];
+                if (visited[u] == 1 && partner[u] == v) {
+                    visited[u] = 2;
+                    order.push_back(u);
+                }
+            }
+        }
+
+        if (pending.empty()) pending.resize(count);
+        size_t rootPartner = mutual(root);
+        for (size_t t = order.size(); t-- > 0;) {
+            size_t v = order[t];
+            vector<size_t>& piece = pending[v];
+            piece.assign(1, v);
+            // A mutual pair sits at the root; the partner keeps a bed free
+            // for it so the pair is never cut in half
+            size_t limit = (v == rootPartner) ? maxGroup - 1 : maxGroup;
+            if (v == root && rootPartner != none) {
+                piece.insert(piece.end(), pending[rootPartner].begin(), pending[rootPartner].end());
+                pending[rootPartner].clear();
+            }
+            for (size_t k = adjStart[v]; k < adjStart[v + 1]; ++k) {
+                size_t u = adjacent[k];
+                if (u == root || partner[u] != v || pending[u].empty()) continue;
+                if (piece.size() + pending[u].size() <= limit) {
+                    piece.insert(piece.end(), pending[u].begin(), pending[u].end());
+                } else if (pending[u].size() >= 2) {
+                    groups.push_back(pending[u]);
+                }
+                pending[u].clear();
+            }
+        }
+        if (pending[root].size() >= 2) groups.push_back(pending[root]);
+        pending[root].clear();
+    }
+
+    stable_sort(groups.begin(), groups.end(),
+        [](const vector<size_t>& a, const vector<size_t>& b) { return a.size() > b.size(); });
+    return groups;
+}
+
+vector<vector<size_t>> RoommateGrouper::pairs(const vector<Student>& students, const HostelIndex& index,
+                                              const vector<size_t>& group) {
+    vector<vector<size_t>> result;
+    vector<uint8_t> paired(group.size(), 0);
+    auto named = [&](size_t member) {
+        return index.studentSlot(students[group[member]].getRoommateKey());
+    };
+    // Mutual pairs first, then one-way preferences
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t a = 0; a < group.size(); ++a) {
+            if (paired[a]) continue;
+            size_t b = find(group.begin(), group.end(), named(a)) - group.begin();
+            if (b == group.size() || b == a || paired[b]) continue;
+            if (pass == 0 && named(b) != group[a]) continue;
+            paired[a] = paired[b] = 1;
+            result.push_back({group[a], group[b]});
+        }
+    }
+    return result;
+}
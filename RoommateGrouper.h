@@ -0,0 +1,51 @@
+/**
+ * @file RoommateGrouper.h
+ * @brief Roommate Groups from the Preference Graph
+ *
+ * Every unallocated student with an unallocated preferred roommate adds
+ * one edge to a graph over the candidates. The graph is built in one pass
+ * (as a flat adjacency array) and walked breadth-first, one connected
+ * component at a time. A component that fits in a room (up to Quad)
+ * becomes one group, so mutual pairs, chains (A -> B -> C) and small
+ * cycles stay together however the students happen to be ordered.
+ *
+ * Larger components are cut into room-sized pieces that stay connected:
+ * every member of a piece named, or was named by, another member. A
+ * mutual pair is never cut in half.
+ *
+ * Groups come back largest first, ready for first-fit-decreasing packing
+ * through HostelIndex::findRoomWithSlots. Students without a usable
+ * roommate preference are not grouped.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ROOMMATEGROUPER_H
+#define ROOMMATEGROUPER_H
+
+#include "Student.h"
+#include "HostelIndex.h"
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+class RoommateGrouper {
+public:
+    // Largest group handed out (a Quad)
+    static const size_t MAX_GROUP = 4;
+
+    // Groups of two or more student slots, at most maxGroup each, largest
+    // first (ties in order of their first student's slot)
+    static vector<vector<size_t>> group(const vector<Student>& students, const HostelIndex& index,
+                                        size_t maxGroup);
+
+    // Disjoint pairs within a group where one named the other, mutual pairs
+    // first: the fallback when no room holds the whole group
+    static vector<vector<size_t>> pairs(const vector<Student>& students, const HostelIndex& index,
+                                        const vector<size_t>& group);
+};
+
+#endif // ROOMMATEGROUPER_H
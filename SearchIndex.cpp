@@ -0,0 +1,372 @@
+#include "SearchIndex.h"
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <iterator>
+
+using namespace std;
+
+namespace {
+    // Side-list entries kept before they are merged into the main list
+    const size_t MERGE_THRESHOLD = 4096;
+    // Stale documents tolerated before the next search rebuilds
+    const size_t MIN_STALE_FOR_REBUILD = 1024;
+    const uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    // Trigram alphabet: a-z, 0-9, '@', '.', and one symbol for anything
+    // else (matches are checked against the text, so sharing is harmless)
+    const uint32_t SYMBOLS = 39;
+    const size_t GRAM_CODES = SYMBOLS * SYMBOLS * SYMBOLS;
+
+    uint32_t symbol(unsigned char c) {
+        if (c >= 'a' && c <= 'z') return c - 'a';
+        if (c >= '0' && c <= '9') return 26 + (c - '0');
+        if (c == '@') return 36;
+        if (c == '.') return 37;
+        return 38;
+    }
+
+    // Letters, digits and UTF-8 bytes make up words
+    bool wordChar(unsigned char c) {
+        return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80;
+    }
+
+    // First 8 bytes of a NUL-terminated word, big-endian and zero padded,
+    // so heads order the same way strcmp does
+    uint64_t headOf(const char* word) {
+        uint64_t head = 0;
+        size_t n = 0;
+        for (; n < 8 && word[n] != '\0'; ++n) head = (head << 8) | static_cast<unsigned char>(word[n]);
+        return n == 0 ? 0 : head << (8 * (8 - n));
+    }
+
+    // Calls visit(code) for every trigram inside the NUL-separated fields
+    // of [first, last)
+    template <typename Visit>
+    void forEachGram(const char* first, const char* last, Visit visit) {
+        for (const char* p = first; p + 2 < last; ++p) {
+            if (p[0] == '\0' || p[1] == '\0' || p[2] == '\0') continue;
+            visit((symbol(p[0]) * SYMBOLS + symbol(p[1])) * SYMBOLS + symbol(p[2]));
+        }
+    }
+}
+
+// Normalisation
+void SearchIndex::appendNormalised(string& out, string_view value) {
+    bool space = false;
+    size_t start = out.size();
+    for (char raw : value) {
+        unsigned char c = static_cast<unsigned char>(raw);
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\0') {
+            space = true;
+            continue;
+        }
+        if (space && out.size() > start) out.push_back(' ');
+        space = false;
+        out.push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : raw);
+    }
+}
+
+string SearchIndex::normalise(string_view value) {
+    string out;
+    appendNormalised(out, value);
+    return out;
+}
+
+bool SearchIndex::parseField(const string& name, unsigned& fields) {
+    if (name == "any") fields = ALL_FIELDS;
+    else if (name == "name") fields = NAME;
+    else if (name == "email") fields = EMAIL;
+    else if (name == "course") fields = COURSE;
+    else return false;
+    return true;
+}
+
+bool SearchIndex::parseMode(const string& name, Mode& mode) {
+    if (name == "prefix") mode = PREFIX;
+    else if (name == "contains") mode = CONTAINS;
+    else return false;
+    return true;
+}
+
+void SearchIndex::documentText(const Student& student) {
+    scratch.clear();
+    appendNormalised(scratch, student.getName());
+    scratch.push_back('\0');
+    appendNormalised(scratch, student.getEmail());
+    scratch.push_back('\0');
+    appendNormalised(scratch, student.getCourse());
+    scratch.push_back('\0');
+}
+
+// Documents
+void SearchIndex::storeText(Doc& doc) {
+    uint32_t base = static_cast<uint32_t>(text.size());
+    size_t nameEnd = scratch.find('\0');
+    size_t emailEnd = scratch.find('\0', nameEnd + 1);
+    doc.name = base;
+    doc.email = base + static_cast<uint32_t>(nameEnd + 1);
+    doc.course = base + static_cast<uint32_t>(emailEnd + 1);
+    doc.end = base + static_cast<uint32_t>(scratch.size());
+    text.append(scratch);
+}
+
+void SearchIndex::addEntries(uint32_t id, const Doc& doc, bool sorted) {
+    // One entry per word start; every field start counts as one
+    for (uint32_t pos = doc.name; pos < doc.end; ++pos) {
+        unsigned char c = static_cast<unsigned char>(text[pos]);
+        if (c == '\0') continue;
+        unsigned char before = (pos == doc.name) ? '\0' : static_cast<unsigned char>(text[pos - 1]);
+        if (before != '\0' && !(wordChar(c) && !wordChar(before))) continue;
+        uint32_t field = (pos < doc.email) ? 0 : (pos < doc.course) ? 1 : 2;
+        Entry entry = {headOf(text.data() + pos), pos, (id << 2) | field};
+        if (!sorted) {
+            entries.push_back(entry);
+            continue;
+        }
+        auto at = upper_bound(recent.begin(), recent.end(), entry,
+            [this](const Entry& a, const Entry& b) { return entryBefore(a, b); });
+        recent.insert(at, entry);
+    }
+    if (recent.size() > MERGE_THRESHOLD) mergeRecent();
+}
+
+void SearchIndex::addGrams(uint32_t id, const Doc& doc) {
+    forEachGram(text.data() + doc.name, text.data() + doc.end, [this, id](uint32_t code) {
+        vector<uint32_t>& list = grams[code];
+        auto at = lower_bound(list.begin(), list.end(), id);
+        if (at == list.end() || *at != id) list.insert(at, id);
+    });
+}
+
+void SearchIndex::mergeRecent() {
+    vector<Entry> merged;
+    merged.reserve(entries.size() + recent.size());
+    merge(entries.begin(), entries.end(), recent.begin(), recent.end(), back_inserter(merged),
+          [this](const Entry& a, const Entry& b) { return entryBefore(a, b); });
+    merged.erase(remove_if(merged.begin(), merged.end(),
+                           [this](const Entry& e) { return !entryLive(e); }),
+                 merged.end());
+    entries.swap(merged);
+    recent.clear();
+}
+
+void SearchIndex::markStale() {
+    // Stale entries and postings cost time on every broad query; start
+    // over once they outweigh the live ones
+    staleDocs++;
+    if (staleDocs >= MIN_STALE_FOR_REBUILD && staleDocs * 2 > docs.size()) reset();
+}
+
+bool SearchIndex::entryBefore(const Entry& a, const Entry& b) const {
+    return a.head < b.head || (a.head == b.head && a.doc < b.doc);
+}
+
+bool SearchIndex::entryLive(const Entry& entry) const {
+    const Doc& doc = docs[entry.doc >> 2];
+    return doc.slot != NO_SLOT && entry.pos >= doc.name && entry.pos < doc.end;
+}
+
+bool SearchIndex::docContains(const Doc& doc, const string& query, unsigned fields) const {
+    if ((fields & NAME) && string_view(text.data() + doc.name).find(query) != string_view::npos) return true;
+    if ((fields & EMAIL) && string_view(text.data() + doc.email).find(query) != string_view::npos) return true;
+    if ((fields & COURSE) && string_view(text.data() + doc.course).find(query) != string_view::npos) return true;
+    return false;
+}
+
+// Queries
+void SearchIndex::prefixMatches(const vector<Entry>& list, const string& query, unsigned fields,
+                                vector<uint64_t>& hits) const {
+    // Entries are ordered by head only, so a query of up to 8 bytes is one
+    // contiguous run; a longer one checks the rest of each word in its run
+    uint64_t head = headOf(query.c_str());
+    uint64_t mask = ~uint64_t(0) << (64 - 8 * min<size_t>(query.size(), 8));
+    bool longQuery = query.size() > 8;
+    auto it = lower_bound(list.begin(), list.end(), head,
+                          [](const Entry& e, uint64_t h) { return e.head < h; });
+    // Entries only go stale through edits and removals
+    bool checkLive = staleDocs > 0;
+    for (; it != list.end(); ++it) {
+        if ((it->head & mask) != head) break;
+        if (!(fields & (1u << (it->doc & 3)))) continue;
+        if (longQuery && strncmp(text.data() + it->pos + 8, query.c_str() + 8, query.size() - 8) != 0) continue;
+        if (checkLive && !entryLive(*it)) continue;
+        uint32_t doc = it->doc >> 2;
+        hits[doc / 64] |= uint64_t(1) << (doc % 64);
+    }
+}
+
+void SearchIndex::containsMatches(const string& query, unsigned fields, vector<uint64_t>& hits) const {
+    // Too short for a trigram: check every document
+    if (query.size() < 3) {
+        for (uint32_t d = 0; d < docs.size(); ++d) {
+            if (docs[d].slot != NO_SLOT && docContains(docs[d], query, fields)) {
+                hits[d / 64] |= uint64_t(1) << (d % 64);
+            }
+        }
+        return;
+    }
+
+    vector<const vector<uint32_t>*> lists;
+    bool missing = false;
+    forEachGram(query.data(), query.data() + query.size(), [&](uint32_t code) {
+        if (grams[code].empty()) missing = true;
+        else lists.push_back(&grams[code]);
+    });
+    if (missing) return;
+    sort(lists.begin(), lists.end(),
+         [](const vector<uint32_t>* a, const vector<uint32_t>* b) { return a->size() < b->size(); });
+    lists.erase(unique(lists.begin(), lists.end()), lists.end());
+
+    // Intersect from the shortest list up; candidates only shrink, and
+    // each longer list is galloped through once
+    vector<uint32_t> candidates(lists[0]->begin(), lists[0]->end());
+    for (size_t k = 1; k < lists.size() && !candidates.empty(); ++k) {
+        const vector<uint32_t>& list = *lists[k];
+        size_t at = 0;
+        size_t kept = 0;
+        for (uint32_t d : candidates) {
+            size_t step = 1;
+            while (at + step < list.size() && list[at + step] < d) {
+                at += step;
+                step *= 2;
+            }
+            at = lower_bound(list.begin() + at, list.begin() + min(list.size(), at + step + 1), d) - list.begin();
+            if (at == list.size()) break;
+            if (list[at] == d) candidates[kept++] = d;
+        }
+        candidates.resize(kept);
+    }
+    for (uint32_t d : candidates) {
+        if (docs[d].slot != NO_SLOT && docContains(docs[d], query, fields)) {
+            hits[d / 64] |= uint64_t(1) << (d % 64);
+        }
+    }
+}
+
+SearchIndex::Page SearchIndex::search(string_view query, unsigned fields, Mode mode,
+                                      size_t offset, size_t limit) const {
+    Page page;
+    string normalised = normalise(query);
+    if (!built || normalised.empty() || (fields & ALL_FIELDS) == 0) return page;
+
+    // One bit per document: duplicates collapse and the bits read back in
+    // document (= slot) order
+    vector<uint64_t> hits((docs.size() + 63) / 64, 0);
+    if (mode == PREFIX) {
+        prefixMatches(entries, normalised, fields, hits);
+        prefixMatches(recent, normalised, fields, hits);
+    } else {
+        containsMatches(normalised, fields, hits);
+    }
+
+    for (size_t w = 0; w < hits.size(); ++w) {
+        if (hits[w] == 0) continue;
+        size_t count = bitset<64>(hits[w]).count();
+        if (page.total + count <= offset || page.slots.size() >= limit) {
+            page.total += count;
+            continue;
+        }
+        for (size_t b = 0; b < 64; ++b) {
+            if (!(hits[w] & (uint64_t(1) << b))) continue;
+            if (page.total >= offset && page.slots.size() < limit) {
+                page.slots.push_back(docs[w * 64 + b].slot);
+            }
+            page.total++;
+        }
+    }
+    return page;
+}
+
+// Building
+bool SearchIndex::isBuilt() const {
+    return built;
+}
+
+void SearchIndex::build(const vector<Student>& students) {
+    reset();
+    docs.reserve(students.size());
+    docOfSlot.reserve(students.size());
+    for (size_t slot = 0; slot < students.size(); ++slot) {
+        Doc doc;
+        doc.slot = static_cast<uint32_t>(slot);
+        documentText(students[slot]);
+        storeText(doc);
+        uint32_t id = static_cast<uint32_t>(docs.size());
+        docs.push_back(doc);
+        docOfSlot.push_back(id);
+        addEntries(id, doc, false);
+    }
+
+    // Posting lists are sized by a counting pass so they carry no slack
+    vector<uint32_t> count(GRAM_CODES, 0);
+    vector<uint32_t> last(GRAM_CODES, NO_SLOT);
+    for (uint32_t d = 0; d < docs.size(); ++d) {
+        forEachGram(text.data() + docs[d].name, text.data() + docs[d].end, [&](uint32_t code) {
+            if (last[code] == d) return;
+            last[code] = d;
+            count[code]++;
+        });
+    }
+    grams.resize(GRAM_CODES);
+    for (size_t code = 0; code < GRAM_CODES; ++code) grams[code].reserve(count[code]);
+    for (uint32_t d = 0; d < docs.size(); ++d) {
+        forEachGram(text.data() + docs[d].name, text.data() + docs[d].end, [&](uint32_t code) {
+            if (grams[code].empty() || grams[code].back() != d) grams[code].push_back(d);
+        });
+    }
+
+    sort(entries.begin(), entries.end(),
+         [this](const Entry& a, const Entry& b) { return entryBefore(a, b); });
+    built = true;
+}
+
+void SearchIndex::reset() {
+    built = false;
+    string().swap(text);
+    vector<Doc>().swap(docs);
+    vector<uint32_t>().swap(docOfSlot);
+    staleDocs = 0;
+    vector<Entry>().swap(entries);
+    vector<Entry>().swap(recent);
+    vector<vector<uint32_t>>().swap(grams);
+}
+
+// Maintenance
+void SearchIndex::studentAppended(const Student& student) {
+    if (!built) return;
+    Doc doc;
+    doc.slot = static_cast<uint32_t>(docOfSlot.size());
+    documentText(student);
+    storeText(doc);
+    uint32_t id = static_cast<uint32_t>(docs.size());
+    docs.push_back(doc);
+    docOfSlot.push_back(id);
+    addEntries(id, doc, true);
+    addGrams(id, doc);
+}
+
+void SearchIndex::studentChanged(size_t slot, const Student& student) {
+    if (!built || slot >= docOfSlot.size()) return;
+    uint32_t id = docOfSlot[slot];
+    Doc& doc = docs[id];
+    // Allocation changes leave the searchable text alone
+    documentText(student);
+    if (text.compare(doc.name, doc.end - doc.name, scratch) == 0) return;
+    // The old text stays behind; its entries fall outside the document's
+    // new range and its postings fail the text check
+    storeText(doc);
+    addEntries(id, doc, true);
+    addGrams(id, doc);
+    markStale();
+}
+
+void SearchIndex::studentErased(size_t slot) {
+    if (!built || slot >= docOfSlot.size()) return;
+    docs[docOfSlot[slot]].slot = NO_SLOT;
+    docOfSlot.erase(docOfSlot.begin() + slot);
+    for (size_t i = slot; i < docOfSlot.size(); ++i) {
+        docs[docOfSlot[i]].slot = static_cast<uint32_t>(i);
+    }
+    markStale();
+}
@@ -0,0 +1,116 @@
+/**
+ * @file SearchIndex.h
+ * @brief Prefix and Substring Search over Student Names, Emails and Courses
+ *
+ * Each student becomes one document: the name, email and course,
+ * normalised (ASCII lower case, runs of spaces collapsed) and stored back
+ * to back, NUL-terminated, in one text buffer. Two indexes point into it:
+ * - Prefix: one entry per word start in each field, sorted by the first
+ *   8 bytes of the text that follows it, so "sha" finds "Pari Shah" and
+ *   every email or course starting with "sha" with one binary search. A
+ *   word runs to the end of its field, so "pari s" matches as well.
+ * - Substring: a posting list of documents per trigram. A query is
+ *   answered by intersecting the lists of its trigrams and checking the
+ *   few survivors against the text. Queries shorter than three characters
+ *   scan the documents instead.
+ *
+ * Documents are kept in student slot order (students are only ever
+ * appended; an edited student keeps its document), so results come back
+ * in vector order, deduplicated, one page at a time, with the total
+ * number of matches.
+ *
+ * Nothing is built until the first search. After that HostelIndex keeps
+ * the index current from its student hooks: new words go to a small
+ * sorted side list that is merged into the main one when it grows, and
+ * an edited student's text is appended again while its old entries are
+ * skipped. Once stale documents outnumber the live ones the next search
+ * rebuilds.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include "Student.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+class SearchIndex {
+public:
+    // Fields a query may match, combined as a bit mask
+    enum Field : unsigned { NAME = 1, EMAIL = 2, COURSE = 4, ALL_FIELDS = 7 };
+    enum Mode { PREFIX, CONTAINS };
+
+    struct Page {
+        vector<size_t> slots; // students on this page, in vector order
+        size_t total = 0;     // matches over all pages
+    };
+
+private:
+    struct Doc {
+        uint32_t slot;        // student slot, NO_SLOT once erased
+        uint32_t name;        // current field offsets into text
+        uint32_t email;
+        uint32_t course;
+        uint32_t end;         // one past the course's NUL
+    };
+
+    struct Entry {
+        uint64_t head;        // first 8 bytes of the word, big-endian, NUL padded
+        uint32_t pos;         // word start in text
+        uint32_t doc;         // document << 2 | field bit (NAME 0, EMAIL 1, COURSE 2)
+    };
+
+    bool built = false;
+    string text;
+    vector<Doc> docs;
+    vector<uint32_t> docOfSlot;
+    size_t staleDocs = 0;     // erased or re-indexed since the build
+    vector<Entry> entries;    // sorted by head, then doc
+    vector<Entry> recent;     // same order; merged into entries when large
+    vector<vector<uint32_t>> grams; // trigram code -> ascending doc ids
+    string scratch;
+
+    static void appendNormalised(string& out, string_view value);
+    void documentText(const Student& student);
+    void storeText(Doc& doc);
+    void addEntries(uint32_t id, const Doc& doc, bool sorted);
+    void addGrams(uint32_t id, const Doc& doc);
+    void mergeRecent();
+    void markStale();
+    bool entryBefore(const Entry& a, const Entry& b) const;
+    bool entryLive(const Entry& entry) const;
+    bool docContains(const Doc& doc, const string& query, unsigned fields) const;
+    void prefixMatches(const vector<Entry>& list, const string& query, unsigned fields,
+                       vector<uint64_t>& hits) const;
+    void containsMatches(const string& query, unsigned fields, vector<uint64_t>& hits) const;
+
+public:
+    // Lower case, spaces collapsed and trimmed (also applied to queries)
+    static string normalise(string_view value);
+    // Command-line names: any, name, email, course / prefix, contains
+    static bool parseField(const string& name, unsigned& fields);
+    static bool parseMode(const string& name, Mode& mode);
+
+    bool isBuilt() const;
+    void build(const vector<Student>& students);
+    void reset();
+
+    // Maintenance (slots follow the students vector); ignored until the
+    // index has been built
+    void studentAppended(const Student& student);
+    void studentChanged(size_t slot, const Student& student);
+    void studentErased(size_t slot);
+
+    // One page of matching students
+    Page search(string_view query, unsigned fields, Mode mode, size_t offset, size_t limit) const;
+};
+
+#endif // SEARCHINDEX_H
@@ -0,0 +1,358 @@
+#include "Snapshot.h"
+#include "CsvReader.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+    const char MAGIC[8] = {'H', 'S', 'T', 'L', 'S', 'N', 'A', 'P'};
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        Snapshot::SourceStamp stamp;
+        uint64_t stringCount;
+        uint64_t stringBytes;
+        uint64_t studentCount;
+        uint64_t preferenceCount;
+        uint64_t roomCount;
+        uint64_t occupantCount;
+        uint64_t adminCount;
+        uint64_t fileSize;
+    };
+
+    size_t align8(size_t n) { return (n + 7) & ~static_cast<size_t>(7); }
+
+    // Appends 8-byte aligned column arrays to a byte buffer
+    class Writer {
+    public:
+        vector<char> bytes;
+        unordered_map<string, uint32_t> ids;
+        vector<string> strings;
+
+        uint32_t intern(const string& s) {
+            auto it = ids.find(s);
+            if (it != ids.end()) return it->second;
+            uint32_t id = static_cast<uint32_t>(strings.size());
+            ids.emplace(s, id);
+            strings.push_back(s);
+            return id;
+        }
+
+        uint32_t intern(string_view s) {
+            return intern(string(s));
+        }
+
+        template <typename T>
+        void column(const vector<T>& values) {
+            bytes.resize(align8(bytes.size()));
+            size_t at = bytes.size();
+            bytes.resize(at + values.size() * sizeof(T));
+            if (!values.empty()) memcpy(bytes.data() + at, values.data(), values.size() * sizeof(T));
+        }
+    };
+
+    // Walks the same column sequence over a mapped file, checking bounds
+    class Reader {
+    public:
+        const char* base;
+        size_t size;
+        size_t pos;
+
+        Reader(const char* base, size_t size, size_t pos) : base(base), size(size), pos(pos) {}
+
+        template <typename T>
+        const T* column(size_t count) {
+            pos = align8(pos);
+            if (pos > size || count > (size - pos) / sizeof(T)) return nullptr;
+            const T* values = reinterpret_cast<const T*>(base + pos);
+            pos += count * sizeof(T);
+            return values;
+        }
+    };
+
+    // Offsets into a list of limit entries: row i spans [offsets[i],
+    // offsets[i + 1]), so every row lies inside the list only if the
+    // offsets never decrease and the last is within limit
+    template <typename T>
+    bool offsetsInBounds(const T* offsets, size_t rows, uint64_t limit) {
+        for (size_t i = 0; i < rows; ++i) {
+            if (offsets[i] > offsets[i + 1]) return false;
+        }
+        return offsets[rows] <= limit;
+    }
+
+    uint64_t fileStampSize(const string& file) {
+        error_code ec;
+        uintmax_t size = filesystem::file_size(file, ec);
+        return ec ? 0 : static_cast<uint64_t>(size);
+    }
+
+    uint64_t fileStampTime(const string& file) {
+        error_code ec;
+        auto time = filesystem::last_write_time(file, ec);
+        return ec ? 0 : static_cast<uint64_t>(time.time_since_epoch().count());
+    }
+}
+
+bool Snapshot::SourceStamp::operator==(const SourceStamp& other) const {
+    for (int i = 0; i < 3; ++i) {
+        if (size[i] != other.size[i] || mtime[i] != other.mtime[i]) return false;
+    }
+    return true;
+}
+
+Snapshot::SourceStamp Snapshot::stampFiles(const string& studentsFile, const string& roomsFile,
+                                           const string& adminsFile) {
+    SourceStamp stamp;
+    const string* files[3] = {&studentsFile, &roomsFile, &adminsFile};
+    for (int i = 0; i < 3; ++i) {
+        stamp.size[i] = fileStampSize(*files[i]);
+        stamp.mtime[i] = fileStampTime(*files[i]);
+    }
+    return stamp;
+}
+
+// Save
+bool Snapshot::save(const string& path, const vector<Student>& students,
+                    const vector<Room>& rooms, const vector<Admin>& admins,
+                    const SourceStamp& stamp) {
+    Writer out;
+    size_t ns = students.size(), nr = rooms.size(), na = admins.size();
+
+    // Student columns
+    vector<uint32_t> sId(ns), sName(ns), sEmail(ns), sPhone(ns), sCourse(ns), sMate(ns), sRoom(ns);
+    vector<int32_t> sYear(ns);
+    vector<uint8_t> sAllocated(ns);
+    vector<uint32_t> prefOffsets(ns + 1, 0), prefList;
+    for (size_t i = 0; i < ns; ++i) {
+        const Student& s = students[i];
+        sId[i] = out.intern(Keys::studentId(s.studentId));
+        sName[i] = out.intern(s.name);
+        sEmail[i] = out.intern(s.email);
+        sPhone[i] = out.intern(s.phone);
+        sCourse[i] = out.intern(s.course);
+        sMate[i] = out.intern(Keys::studentId(s.preferredRoommate));
+        sRoom[i] = out.intern(Keys::roomNumber(s.allocatedRoom));
+        sYear[i] = s.year;
+        sAllocated[i] = s.isAllocated ? 1 : 0;
+        for (RoomKey pref : s.preferences) prefList.push_back(out.intern(Keys::roomNumber(pref)));
+        prefOffsets[i + 1] = static_cast<uint32_t>(prefList.size());
+    }
+
+    // Room columns
+    vector<uint32_t> rNumber(nr), rType(nr), rFloor(nr), rBlock(nr);
+    vector<int32_t> rCapacity(nr), rOccupancy(nr);
+    vector<double> rRent(nr);
+    vector<uint8_t> rAvailable(nr);
+    vector<uint32_t> occOffsets(nr + 1, 0), occList;
+    for (size_t i = 0; i < nr; ++i) {
+        const Room& r = rooms[i];
+        rNumber[i] = out.intern(Keys::roomNumber(r.roomNumber));
+        rType[i] = out.intern(r.roomType);
+        rFloor[i] = out.intern(r.floor);
+        rBlock[i] = out.intern(r.block);
+        rCapacity[i] = r.capacity;
+        rOccupancy[i] = r.currentOccupancy;
+        rRent[i] = r.rent;
+        rAvailable[i] = r.isAvailable ? 1 : 0;
+        for (StudentKey occupant : r.occupants) occList.push_back(out.intern(Keys::studentId(occupant)));
+        occOffsets[i + 1] = static_cast<uint32_t>(occList.size());
+    }
+
+    // Admin columns
+    vector<uint32_t> aId(na), aUser(na), aPass(na), aName(na), aEmail(na);
+    for (size_t i = 0; i < na; ++i) {
+        aId[i] = out.intern(admins[i].adminId);
+        aUser[i] = out.intern(admins[i].username);
+        aPass[i] = out.intern(admins[i].password);
+        aName[i] = out.intern(admins[i].name);
+        aEmail[i] = out.intern(admins[i].email);
+    }
+
+    // String table
+    vector<uint64_t> stringOffsets(out.strings.size() + 1, 0);
+    vector<char> blob;
+    for (size_t i = 0; i < out.strings.size(); ++i) {
+        blob.insert(blob.end(), out.strings[i].begin(), out.strings[i].end());
+        stringOffsets[i + 1] = blob.size();
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.stamp = stamp;
+    header.stringCount = out.strings.size();
+    header.stringBytes = blob.size();
+    header.studentCount = ns;
+    header.preferenceCount = prefList.size();
+    header.roomCount = nr;
+    header.occupantCount = occList.size();
+    header.adminCount = na;
+
+    out.bytes.resize(sizeof(Header));
+    out.column(stringOffsets);
+    out.column(blob);
+    out.column(sId); out.column(sName); out.column(sEmail); out.column(sPhone);
+    out.column(sCourse); out.column(sMate); out.column(sRoom);
+    out.column(sYear); out.column(sAllocated);
+    out.column(prefOffsets); out.column(prefList);
+    out.column(rNumber); out.column(rType); out.column(rFloor); out.column(rBlock);
+    out.column(rCapacity); out.column(rOccupancy); out.column(rRent); out.column(rAvailable);
+    out.column(occOffsets); out.column(occList);
+    out.column(aId); out.column(aUser); out.column(aPass); out.column(aName); out.column(aEmail);
+    header.fileSize = out.bytes.size();
+    memcpy(out.bytes.data(), &header, sizeof(header));
+
+    // Write to a side file and rename so a crash never leaves a torn snapshot
+    string tempPath = path + ".tmp";
+    {
+        ofstream file(tempPath, ios::binary | ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(out.bytes.data(), static_cast<streamsize>(out.bytes.size()));
+        if (!file) return false;
+    }
+    error_code ec;
+    filesystem::rename(tempPath, path, ec);
+    return !ec;
+}
+
+// Load
+bool Snapshot::load(const string& path, const SourceStamp& expected,
+                    vector<Student>& students, vector<Room>& rooms, vector<Admin>& admins,
+                    pmr::memory_resource* memory) {
+    MappedFile file;
+    if (!file.open(path) || file.size() < sizeof(Header)) return false;
+
+    Header header;
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.byteOrder != BYTE_ORDER_MARK || header.fileSize != file.size() ||
+        !(header.stamp == expected)) {
+        return false;
+    }
+
+    // Every counted item takes at least a byte, so no count can exceed the
+    // file; this also keeps the count + 1 offset columns from overflowing
+    const uint64_t counts[] = {header.stringCount, header.stringBytes, header.studentCount,
+                               header.preferenceCount, header.roomCount, header.occupantCount,
+                               header.adminCount};
+    for (uint64_t count : counts) {
+        if (count > file.size()) return false;
+    }
+
+    size_t ns = header.studentCount, nr = header.roomCount, na = header.adminCount;
+    Reader in(file.data(), file.size(), sizeof(Header));
+    const uint64_t* stringOffsets = in.column<uint64_t>(header.stringCount + 1);
+    const char* blob = in.column<char>(header.stringBytes);
+    const uint32_t* sId = in.column<uint32_t>(ns);
+    const uint32_t* sName = in.column<uint32_t>(ns);
+    const uint32_t* sEmail = in.column<uint32_t>(ns);
+    const uint32_t* sPhone = in.column<uint32_t>(ns);
+    const uint32_t* sCourse = in.column<uint32_t>(ns);
+    const uint32_t* sMate = in.column<uint32_t>(ns);
+    const uint32_t* sRoom = in.column<uint32_t>(ns);
+    const int32_t* sYear = in.column<int32_t>(ns);
+    const uint8_t* sAllocated = in.column<uint8_t>(ns);
+    const uint32_t* prefOffsets = in.column<uint32_t>(ns + 1);
+    const uint32_t* prefList = in.column<uint32_t>(header.preferenceCount);
+    const uint32_t* rNumber = in.column<uint32_t>(nr);
+    const uint32_t* rType = in.column<uint32_t>(nr);
+    const uint32_t* rFloor = in.column<uint32_t>(nr);
+    const uint32_t* rBlock = in.column<uint32_t>(nr);
+    const int32_t* rCapacity = in.column<int32_t>(nr);
+    const int32_t* rOccupancy = in.column<int32_t>(nr);
+    const double* rRent = in.column<double>(nr);
+    const uint8_t* rAvailable = in.column<uint8_t>(nr);
+    const uint32_t* occOffsets = in.column<uint32_t>(nr + 1);
+    const uint32_t* occList = in.column<uint32_t>(header.occupantCount);
+    const uint32_t* aId = in.column<uint32_t>(na);
+    const uint32_t* aUser = in.column<uint32_t>(na);
+    const uint32_t* aPass = in.column<uint32_t>(na);
+    const uint32_t* aName = in.column<uint32_t>(na);
+    const uint32_t* aEmail = in.column<uint32_t>(na);
+    if (!stringOffsets || !blob || !sId || !sName || !sEmail || !sPhone || !sCourse || !sMate ||
+        !sRoom || !sYear || !sAllocated || !prefOffsets || !prefList || !rNumber || !rType ||
+        !rFloor || !rBlock || !rCapacity || !rOccupancy || !rRent || !rAvailable ||
+        !occOffsets || !occList || !aId || !aUser || !aPass || !aName || !aEmail) {
+        return false;
+    }
+    // All offsets are checked before any record is read, so a torn or
+    // corrupt snapshot is rejected instead of read past its mapping
+    if (!offsetsInBounds(stringOffsets, header.stringCount, header.stringBytes) ||
+        !offsetsInBounds(prefOffsets, ns, header.preferenceCount) ||
+        !offsetsInBounds(occOffsets, nr, header.occupantCount)) {
+        return false;
+    }
+    // Every string id must resolve inside the table; with the offsets
+    // checked, an id below stringCount spans bytes within the blob
+    bool valid = true;
+    auto text = [&](uint32_t id) -> string_view {
+        if (id >= header.stringCount) {
+            valid = false;
+            return string_view();
+        }
+        return string_view(blob + stringOffsets[id],
+                           static_cast<size_t>(stringOffsets[id + 1] - stringOffsets[id]));
+    };
+
+    vector<Student> loadedStudents;
+    loadedStudents.reserve(ns);
+    for (size_t i = 0; i < ns && valid; ++i) {
+        Student& s = loadedStudents.emplace_back(memory);
+        s.studentId = Keys::student(text(sId[i]));
+        s.name.assign(text(sName[i]));
+        s.email.assign(text(sEmail[i]));
+        s.phone.assign(text(sPhone[i]));
+        s.course.assign(text(sCourse[i]));
+        s.preferredRoommate = Keys::student(text(sMate[i]));
+        s.allocatedRoom = Keys::room(text(sRoom[i]));
+        s.year = sYear[i];
+        s.isAllocated = sAllocated[i] != 0;
+        s.preferences.reserve(prefOffsets[i + 1] - prefOffsets[i]);
+        for (uint32_t p = prefOffsets[i]; p < prefOffsets[i + 1]; ++p) {
+            s.preferences.push_back(Keys::room(text(prefList[p])));
+        }
+    }
+
+    vector<Room> loadedRooms;
+    loadedRooms.reserve(nr);
+    for (size_t i = 0; i < nr && valid; ++i) {
+        Room& r = loadedRooms.emplace_back(memory);
+        r.roomNumber = Keys::room(text(rNumber[i]));
+        r.roomType.assign(text(rType[i]));
+        r.floor.assign(text(rFloor[i]));
+        r.block.assign(text(rBlock[i]));
+        r.capacity = rCapacity[i];
+        r.currentOccupancy = rOccupancy[i];
+        r.rent = rRent[i];
+        r.isAvailable = rAvailable[i] != 0;
+        r.occupants.reserve(occOffsets[i + 1] - occOffsets[i]);
+        for (uint32_t o = occOffsets[i]; o < occOffsets[i + 1]; ++o) {
+            r.occupants.push_back(Keys::student(text(occList[o])));
+        }
+    }
+
+    vector<Admin> loadedAdmins(na);
+    for (size_t i = 0; i < na && valid; ++i) {
+        Admin& a = loadedAdmins[i];
+        a.adminId.assign(text(aId[i]));
+        a.username.assign(text(aUser[i]));
+        a.password.assign(text(aPass[i]));
+        a.name.assign(text(aName[i]));
+        a.email.assign(text(aEmail[i]));
+    }
+    if (!valid) return false;
+
+    students.swap(loadedStudents);
+    rooms.swap(loadedRooms);
+    admins.swap(loadedAdmins);
+    return true;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file Snapshot.h
+ * @brief Binary Snapshot Format for Hostel Allotment System
+ *
+ * A versioned, mmap-friendly binary image of the students, rooms and
+ * admins vectors. CSV stays the interchange format; the snapshot is a
+ * startup cache written next to the CSVs on every compaction and used
+ * only while the CSVs are unchanged since it was written.
+ *
+ * Layout (native little-endian, every section 8-byte aligned):
+ * - Header: magic, version, byte-order mark, section offsets, counts and
+ *   the size/mtime of each source CSV
+ * - String table: uint64 offsets[count + 1] + one byte blob; every text
+ *   field is a uint32 index into it, repeated values stored once
+ * - Student columns: id, name, email, phone, course, roommate, room
+ *   (uint32 string ids), year (int32), allocated (uint8), preference
+ *   offsets (uint32[count + 1]) into a flat uint32 preference list
+ * - Room columns: number, type, floor, block (uint32), capacity and
+ *   occupancy (int32), rent (double), available (uint8), occupant
+ *   offsets (uint32[count + 1]) into a flat uint32 occupant list
+ * - Admin columns: id, username, password, name, email (uint32)
+ *
+ * Loading maps the file and slices strings straight out of the blob; no
+ * field is parsed from text.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "Student.h"
+#include "Room.h"
+#include "Admin.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Snapshot {
+public:
+    // Size and modification time of the CSVs the snapshot was taken from
+    struct SourceStamp {
+        uint64_t size[3];
+        uint64_t mtime[3];
+        bool operator==(const SourceStamp& other) const;
+    };
+
+    static const uint32_t VERSION = 1;
+
+    static SourceStamp stampFiles(const string& studentsFile, const string& roomsFile,
+                                  const string& adminsFile);
+
+    static bool save(const string& path, const vector<Student>& students,
+                     const vector<Room>& rooms, const vector<Admin>& admins,
+                     const SourceStamp& stamp);
+
+    // Fails (leaving the vectors untouched) when the file is missing,
+    // malformed, from another version, or stamped for different CSVs.
+    // Student and room payloads are placed in memory
+    static bool load(const string& path, const SourceStamp& expected,
+                     vector<Student>& students, vector<Room>& rooms, vector<Admin>& admins,
+                     pmr::memory_resource* memory);
+};
+
+#endif // SNAPSHOT_H
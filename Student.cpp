@@ -1,129 +1,95 @@
 #include "Student.h"
-#include <regex>
+#include "CsvUtils.h"
+#include "CsvReader.h"
+#include "Validation.h"
 #include <algorithm>
-#include <sstream>
 
 using namespace std;
 
-namespace {
-    static inline string trim(const string& s) {
-        size_t start = s.find_first_not_of(" \t\r\n");
-        if (start == string::npos) return "";
-        size_t end = s.find_last_not_of(" \t\r\n");
-        return s.substr(start, end - start + 1);
-    }
-    string csvEscape(const string& value) {
-        bool needsQuotes = value.find_first_of(",\"\n") != string::npos;
-        string out = value;
-        // Escape quotes by doubling them
-        size_t pos = 0;
-        while ((pos = out.find('"', pos)) != string::npos) {
-            out.insert(pos, 1, '"');
-            pos += 2;
-        }
-        if (needsQuotes) {
-            return string("\"") + out + string("\"");
-        }
-        return out;
-    }
-
-    vector<string> csvParseLine(const string& line) {
-        vector<string> result;
-        string cur;
-        bool inQuotes = false;
-        for (size_t i = 0; i < line.size(); ++i) {
-            char c = line[i];
-            if (inQuotes) {
-                if (c == '"') {
-                    if (i + 1 < line.size() && line[i + 1] == '"') {
-                        cur.push_back('"');
-                        ++i; // skip escaped quote
-                    } else {
-                        inQuotes = false;
-                    }
-                } else {
-                    cur.push_back(c);
-                }
-            } else {
-                if (c == ',') {
-                    result.push_back(cur);
-                    cur.clear();
-                } else if (c == '"') {
-                    inQuotes = true;
-                } else {
-                    cur.push_back(c);
-                }
-            }
-        }
-        result.push_back(cur);
-        for (auto& t : result) t = trim(t);
-        return result;
-    }
-}
-
 // Default constructor
-Student::Student() : studentId(""), name(""), email(""), phone(""), 
-                     course(""), year(0), preferredRoommate(""), 
-                     allocatedRoom(""), isAllocated(false) {}
+Student::Student() : studentId(Keys::NONE), name(""), email(""), phone(""), 
+                     course(""), year(0), preferredRoommate(Keys::NONE), 
+                     allocatedRoom(Keys::NONE), isAllocated(false) {}
+
+// Constructor for loaders: strings and preferences live in memory
+Student::Student(pmr::memory_resource* memory)
+    : studentId(Keys::NONE), name(memory), email(memory), phone(memory), course(memory),
+      year(0), preferredRoommate(Keys::NONE), allocatedRoom(Keys::NONE), isAllocated(false),
+      preferences(memory) {}
 
 // Parameterized constructor
 Student::Student(const string& id, const string& name, const string& email, 
                  const string& phone, const string& course, int year)
-    : studentId(id), name(name), email(email), phone(phone), course(course), 
-      year(year), preferredRoommate(""), allocatedRoom(""), isAllocated(false) {}
+    : studentId(Keys::student(id)), name(name), email(email), phone(phone), course(course), 
+      year(year), preferredRoommate(Keys::NONE), allocatedRoom(Keys::NONE), isAllocated(false) {}
 
 // Getters
-string Student::getStudentId() const { return studentId; }
-string Student::getName() const { return name; }
-string Student::getEmail() const { return email; }
-string Student::getPhone() const { return phone; }
-string Student::getCourse() const { return course; }
+string Student::getStudentId() const { return Keys::studentId(studentId); }
+string_view Student::getName() const { return name; }
+string_view Student::getEmail() const { return email; }
+string_view Student::getPhone() const { return phone; }
+string_view Student::getCourse() const { return course; }
 int Student::getYear() const { return year; }
-string Student::getPreferredRoommate() const { return preferredRoommate; }
-string Student::getAllocatedRoom() const { return allocatedRoom; }
+string Student::getPreferredRoommate() const { return Keys::studentId(preferredRoommate); }
+string Student::getAllocatedRoom() const { return Keys::roomNumber(allocatedRoom); }
 bool Student::getIsAllocated() const { return isAllocated; }
-vector<string> Student::getPreferences() const { return preferences; }
+
+vector<string> Student::getPreferences() const {
+    vector<string> rooms;
+    rooms.reserve(preferences.size());
+    for (RoomKey room : preferences) rooms.push_back(Keys::roomNumber(room));
+    return rooms;
+}
+
+StudentKey Student::getKey() const { return studentId; }
+StudentKey Student::getRoommateKey() const { return preferredRoommate; }
+RoomKey Student::getRoomKey() const { return allocatedRoom; }
+const pmr::vector<RoomKey>& Student::getPreferenceKeys() const { return preferences; }
 
 // Setters
-void Student::setStudentId(const string& id) { studentId = id; }
-void Student::setName(const string& name) { this->name = name; }
-void Student::setEmail(const string& email) { this->email = email; }
-void Student::setPhone(const string& phone) { this->phone = phone; }
-void Student::setCourse(const string& course) { this->course = course; }
+void Student::setStudentId(const string& id) { studentId = Keys::student(id); }
+void Student::setName(const string& name) { this->name.assign(name); }
+void Student::setEmail(const string& email) { this->email.assign(email); }
+void Student::setPhone(const string& phone) { this->phone.assign(phone); }
+void Student::setCourse(const string& course) { this->course.assign(course); }
 void Student::setYear(int year) { this->year = year; }
-void Student::setPreferredRoommate(const string& roommate) { preferredRoommate = roommate; }
+void Student::setPreferredRoommate(const string& roommate) { preferredRoommate = Keys::student(roommate); }
 void Student::setAllocatedRoom(const string& room) { 
-    allocatedRoom = room; 
-    isAllocated = (room != "");
+    setRoomKey(Keys::room(room));
+}
+void Student::setRoomKey(RoomKey room) {
+    allocatedRoom = room;
+    isAllocated = (room != Keys::NONE);
 }
 void Student::setIsAllocated(bool allocated) { isAllocated = allocated; }
 
 void Student::addPreference(const string& room) {
-    if (find(preferences.begin(), preferences.end(), room) == preferences.end()) {
-        preferences.push_back(room);
+    RoomKey key = Keys::room(room);
+    if (key != Keys::NONE && find(preferences.begin(), preferences.end(), key) == preferences.end()) {
+        preferences.push_back(key);
     }
 }
 
 // Display student information
-void Student::displayInfo() const {
-    cout << "\n=== Student Information ===" << endl;
-    cout << "Student ID: " << studentId << endl;
-    cout << "Name: " << name << endl;
-    cout << "Email: " << email << endl;
-    cout << "Phone: " << phone << endl;
-    cout << "Course: " << course << endl;
-    cout << "Year: " << year << endl;
-    cout << "Preferred Roommate: " << (preferredRoommate.empty() ? "None" : preferredRoommate) << endl;
-    cout << "Allocated Room: " << (allocatedRoom.empty() ? "Not Allocated" : allocatedRoom) << endl;
-    cout << "Status: " << (isAllocated ? "Allocated" : "Not Allocated") << endl;
+void Student::displayInfo(ostream& out) const {
+    out << "\n=== Student Information ===" << endl;
+    out << "Student ID: " << getStudentId() << endl;
+    out << "Name: " << name << endl;
+    out << "Email: " << email << endl;
+    out << "Phone: " << phone << endl;
+    out << "Course: " << course << endl;
+    out << "Year: " << year << endl;
+    out << "Preferred Roommate: " << (preferredRoommate == Keys::NONE ? "None" : getPreferredRoommate()) << endl;
+    out << "Allocated Room: " << (allocatedRoom == Keys::NONE ? "Not Allocated" : getAllocatedRoom()) << endl;
+    out << "Status: " << (isAllocated ? "Allocated" : "Not Allocated") << endl;
     
     if (!preferences.empty()) {
-        cout << "Room Preferences: ";
+        out << "Room Preferences: ";
         for (size_t i = 0; i < preferences.size(); ++i) {
-            cout << preferences[i];
-            if (i < preferences.size() - 1) cout << ", ";
+            out << Keys::roomNumber(preferences[i]);
+            if (i < preferences.size() - 1) out << ", ";
         }
-        cout << endl;
+        out << endl;
     }
 }
 
@@ -131,8 +97,10 @@ void Student::displayInfo() const {
 void Student::inputDetails() {
     cout << "\n=== Enter Student Details ===" << endl;
     
+    string input;
     cout << "Enter Student ID: ";
-    getline(cin, studentId);
+    getline(cin, input);
+    studentId = Keys::student(input);
     
     cout << "Enter Name: ";
     getline(cin, name);
@@ -166,90 +134,79 @@ void Student::inputDetails() {
     } while (year < 1 || year > 4);
     
     cout << "Enter Preferred Roommate ID (or press Enter for none): ";
-    getline(cin, preferredRoommate);
+    getline(cin, input);
+    preferredRoommate = Keys::student(input);
 }
 
 // Email validation
-bool Student::isValidEmail(const string& email) const {
-    regex emailRegex(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-    return regex_match(email, emailRegex);
+bool Student::isValidEmail(string_view email) const {
+    return Validation::isEmail(email);
 }
 
 // Phone validation
-bool Student::isValidPhone(const string& phone) const {
-    regex phoneRegex(R"(\d{10})");
-    return regex_match(phone, phoneRegex);
+bool Student::isValidPhone(string_view phone) const {
+    return Validation::isPhone(phone);
 }
 
 // Save to CSV file
-void Student::saveToFile(ofstream& file) const {
+void Student::saveToFile(ostream& file) const {
     // Join preferences with ';' to keep single CSV cell
     string prefs;
     for (size_t i = 0; i < preferences.size(); ++i) {
         if (i) prefs += ';';
-        prefs += preferences[i];
+        Keys::appendRoomNumber(prefs, preferences[i]);
     }
-    file
-        << csvEscape(studentId) << ','
-        << csvEscape(name) << ','
-        << csvEscape(email) << ','
-        << csvEscape(phone) << ','
-        << csvEscape(course) << ','
-        << year << ','
-        << csvEscape(preferredRoommate) << ','
-        << csvEscape(allocatedRoom) << ','
-        << (isAllocated ? 1 : 0) << ','
-        << csvEscape(prefs)
-        << '\n';
+    // Fields go straight to the stream; only the key columns are formatted
+    csvWrite(file, getStudentId()) << ',';
+    csvWrite(file, name) << ',';
+    csvWrite(file, email) << ',';
+    csvWrite(file, phone) << ',';
+    csvWrite(file, course) << ',' << year << ',';
+    csvWrite(file, getPreferredRoommate()) << ',';
+    csvWrite(file, getAllocatedRoom()) << ',' << (isAllocated ? 1 : 0) << ',';
+    csvWrite(file, prefs) << '\n';
 }
 
 // Load from CSV (generic istream); returns success
 bool Student::loadFromFile(istream& is) {
     string line;
-    if (!getline(is, line)) return false;
-    vector<string> tokens = csvParseLine(line);
-    if (tokens.size() < 9) return false;
-    studentId = tokens[0];
-    name = tokens[1];
-    email = tokens[2];
-    phone = tokens[3];
-    course = tokens[4];
-    year = tokens[5].empty() ? 0 : stoi(tokens[5]);
-    preferredRoommate = tokens[6];
-    allocatedRoom = tokens[7];
-    isAllocated = (!tokens[8].empty() && tokens[8] != "0");
+    if (!csvReadRecord(is, line)) return false;
+    return loadFromTokens(csvParseLine(line));
+}
+
+// Load from already-split CSV fields; returns success
+bool Student::loadFromTokens(const vector<string>& tokens) {
+    vector<string_view> fields(tokens.begin(), tokens.end());
+    return loadFromFields(fields);
+}
+
+// Load from string_view fields (zero-copy loaders); one copy per owned field
+bool Student::loadFromFields(const vector<string_view>& fields) {
+    if (fields.size() < 9) return false;
+    studentId = Keys::student(fields[0]);
+    name.assign(fields[1]);
+    email.assign(fields[2]);
+    phone.assign(fields[3]);
+    course.assign(fields[4]);
+    year = csvToInt(fields[5]);
+    preferredRoommate = Keys::student(fields[6]);
+    allocatedRoom = Keys::room(fields[7]);
+    isAllocated = (!fields[8].empty() && fields[8] != "0");
     preferences.clear();
-    if (tokens.size() > 9 && !tokens[9].empty()) {
-        stringstream prefStream(tokens[9]);
-        string pref;
-        while (getline(prefStream, pref, ';')) {
-            pref = trim(pref);
-            if (!pref.empty()) preferences.push_back(pref);
+    if (fields.size() > 9 && !fields[9].empty()) {
+        // Preferences share one cell, separated by ';'
+        string_view rest = fields[9];
+        while (!rest.empty()) {
+            size_t cut = rest.find(';');
+            string_view pref = csvTrimView(rest.substr(0, cut));
+            if (!pref.empty()) preferences.push_back(Keys::room(pref));
+            if (cut == string_view::npos) break;
+            rest.remove_prefix(cut + 1);
         }
     }
     return true;
 }
 
-void Student::saveToFile(ostream& os) const {
-    string prefs;
-    for (size_t i = 0; i < preferences.size(); ++i) {
-        if (i) prefs += ';';
-        prefs += preferences[i];
-    }
-    os
-        << csvEscape(studentId) << ','
-        << csvEscape(name) << ','
-        << csvEscape(email) << ','
-        << csvEscape(phone) << ','
-        << csvEscape(course) << ','
-        << year << ','
-        << csvEscape(preferredRoommate) << ','
-        << csvEscape(allocatedRoom) << ','
-        << (isAllocated ? 1 : 0) << ','
-        << csvEscape(prefs)
-        << '\n';
-}
-
 // Output operator
 ostream& operator<<(ostream& os, const Student& student) {
     student.saveToFile(os);
@@ -20,8 +20,11 @@
 #ifndef STUDENT_H
 #define STUDENT_H
 
+#include "Keys.h"
 #include <string>
+#include <string_view>
 #include <vector>
+#include <memory_resource>
 #include <iostream>
 #include <fstream>
 
@@ -29,35 +32,45 @@ using namespace std;
 
 class Student {
 private:
-    string studentId;
-    string name;
-    string email;
-    string phone;
-    string course;
+    // Strings and lists are pmr containers so loaders can place them in a
+    // LoadArena region; copies of a record always use the heap
+    StudentKey studentId;        // integer key, see Keys.h
+    pmr::string name;
+    pmr::string email;
+    pmr::string phone;
+    pmr::string course;
     int year;
-    string preferredRoommate;
-    string allocatedRoom;
+    StudentKey preferredRoommate; // Keys::NONE when none
+    RoomKey allocatedRoom;        // Keys::NONE when unallocated
     bool isAllocated;
-    vector<string> preferences; // Room preferences
+    pmr::vector<RoomKey> preferences; // Room preferences
 
 public:
     // Constructors
     Student();
+    explicit Student(pmr::memory_resource* memory);
     Student(const string& id, const string& name, const string& email, 
             const string& phone, const string& course, int year);
     
-    // Getters
+    // Getters (string forms are for display and files; views last as
+    // long as the record is unchanged)
     string getStudentId() const;
-    string getName() const;
-    string getEmail() const;
-    string getPhone() const;
-    string getCourse() const;
+    string_view getName() const;
+    string_view getEmail() const;
+    string_view getPhone() const;
+    string_view getCourse() const;
     int getYear() const;
     string getPreferredRoommate() const;
     string getAllocatedRoom() const;
     bool getIsAllocated() const;
     vector<string> getPreferences() const;
     
+    // Key getters
+    StudentKey getKey() const;
+    StudentKey getRoommateKey() const;
+    RoomKey getRoomKey() const;
+    const pmr::vector<RoomKey>& getPreferenceKeys() const;
+    
     // Setters
     void setStudentId(const string& id);
     void setName(const string& name);
@@ -67,18 +80,26 @@ public:
     void setYear(int year);
     void setPreferredRoommate(const string& roommate);
     void setAllocatedRoom(const string& room);
+    void setRoomKey(RoomKey room);
     void setIsAllocated(bool allocated);
     void addPreference(const string& room);
     
     // Utility functions
-    void displayInfo() const;
+    void displayInfo(ostream& out) const;
     void inputDetails();
-    bool isValidEmail(const string& email) const;
-    bool isValidPhone(const string& phone) const;
+    bool isValidEmail(string_view email) const;
+    bool isValidPhone(string_view phone) const;
     
     // File operations
     void saveToFile(ostream& os) const;
     bool loadFromFile(istream& is);
+    bool loadFromTokens(const vector<string>& tokens);
+    bool loadFromFields(const vector<string_view>& fields);
+    
+    // Binary snapshots read and write the fields directly
+    friend class Snapshot;
+    // Reports count courses straight from the stored strings
+    friend class ReportEngine;
     
     // Friend functions for file operations
     friend ostream& operator<<(ostream& os, const Student& student);
@@ -0,0 +1,110 @@
+#include "Validation.h"
+
+using namespace std;
+
+namespace {
+    // Character classes of the email rule, one table lookup per byte
+    const uint8_t LOCAL = 1;   // [a-zA-Z0-9._%+-]
+    const uint8_t DOMAIN = 2;  // [a-zA-Z0-9.-]
+    const uint8_t ALPHA = 4;   // [a-zA-Z]
+
+    struct CharClasses {
+        uint8_t table[256];
+
+        CharClasses() : table() {
+            for (int c = 'a'; c <= 'z'; ++c) table[c] = LOCAL | DOMAIN | ALPHA;
+            for (int c = 'A'; c <= 'Z'; ++c) table[c] = LOCAL | DOMAIN | ALPHA;
+            for (int c = '0'; c <= '9'; ++c) table[c] = LOCAL | DOMAIN;
+            table[static_cast<unsigned char>('.')] = LOCAL | DOMAIN;
+            table[static_cast<unsigned char>('-')] = LOCAL | DOMAIN;
+            table[static_cast<unsigned char>('_')] = LOCAL;
+            table[static_cast<unsigned char>('%')] = LOCAL;
+            table[static_cast<unsigned char>('+')] = LOCAL;
+        }
+
+        bool is(char c, uint8_t cls) const {
+            return (table[static_cast<unsigned char>(c)] & cls) != 0;
+        }
+    };
+
+    const CharClasses classes;
+
+    bool digitsOfLength(string_view s, size_t length) {
+        if (s.size() != length) return false;
+        for (char c : s) {
+            if (c < '0' || c > '9') return false;
+        }
+        return true;
+    }
+}
+
+// Single fields
+bool Validation::isStudentId(string_view id) {
+    return digitsOfLength(id, 13);
+}
+
+bool Validation::isPhone(string_view phone) {
+    return digitsOfLength(phone, 10);
+}
+
+bool Validation::isEmail(string_view email) {
+    // Neither class contains '@', so the split is the only '@'
+    size_t at = email.find('@');
+    if (at == 0 || at == string_view::npos) return false;
+    for (size_t i = 0; i < at; ++i) {
+        if (!classes.is(email[i], LOCAL)) return false;
+    }
+    string_view domain = email.substr(at + 1);
+    for (char c : domain) {
+        if (!classes.is(c, DOMAIN)) return false;
+    }
+    // The letters-only suffix cannot contain '.', so it follows the last
+    // dot; the host part before it must be non-empty
+    size_t dot = domain.rfind('.');
+    if (dot == 0 || dot == string_view::npos || domain.size() - dot - 1 < 2) return false;
+    for (size_t i = dot + 1; i < domain.size(); ++i) {
+        if (!classes.is(domain[i], ALPHA)) return false;
+    }
+    return true;
+}
+
+bool Validation::isYear(int year) {
+    return year >= 1 && year <= 4;
+}
+
+// Whole records
+uint8_t Validation::validate(const Student& student) {
+    uint8_t errors = OK;
+    // Only 13-digit IDs get a numeric key (Keys.h); anything else is
+    // interned or missing
+    StudentKey key = student.getKey();
+    if (key == Keys::NONE || (key & Keys::INTERNED)) errors |= BAD_ID;
+    if (!isEmail(student.getEmail())) errors |= BAD_EMAIL;
+    if (!isPhone(student.getPhone())) errors |= BAD_PHONE;
+    if (!isYear(student.getYear())) errors |= BAD_YEAR;
+    return errors;
+}
+
+vector<uint8_t> Validation::validateAll(const vector<Student>& students) {
+    vector<uint8_t> errors(students.size(), OK);
+    for (size_t i = 0; i < students.size(); ++i) {
+        errors[i] = validate(students[i]);
+    }
+    return errors;
+}
+
+string Validation::describe(uint8_t errors) {
+    static const pair<uint8_t, const char*> names[] = {
+        {BAD_ID, "invalid ID"},
+        {BAD_EMAIL, "invalid email"},
+        {BAD_PHONE, "invalid phone"},
+        {BAD_YEAR, "invalid year"}
+    };
+    string text;
+    for (const auto& name : names) {
+        if (!(errors & name.first)) continue;
+        if (!text.empty()) text += ", ";
+        text += name.second;
+    }
+    return text.empty() ? "ok" : text;
+}
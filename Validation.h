@@ -0,0 +1,58 @@
+/**
+ * @file Validation.h
+ * @brief Field Validators for Student Records
+ *
+ * Hand-written matchers for the student field rules, shared by the
+ * interactive input paths and the bulk loaders. They accept exactly what
+ * the former std::regex patterns accepted, without compiling a pattern
+ * per call:
+ * - Student ID: exactly 13 digits             (\d{13})
+ * - Phone:      exactly 10 digits             (\d{10})
+ * - Email:      [a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}
+ * - Year:       1-4
+ *
+ * Record checks return a bit set of Error flags so one pass reports
+ * every problem with a row.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef VALIDATION_H
+#define VALIDATION_H
+
+#include "Student.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+class Validation {
+public:
+    enum Error : uint8_t {
+        OK        = 0,
+        BAD_ID    = 1 << 0,
+        BAD_EMAIL = 1 << 1,
+        BAD_PHONE = 1 << 2,
+        BAD_YEAR  = 1 << 3
+    };
+
+    // Single fields
+    static bool isStudentId(string_view id);
+    static bool isPhone(string_view phone);
+    static bool isEmail(string_view email);
+    static bool isYear(int year);
+
+    // Whole records: OK or an OR of Error flags
+    static uint8_t validate(const Student& student);
+    // One code per row, in the order of students
+    static vector<uint8_t> validateAll(const vector<Student>& students);
+
+    // "invalid ID, invalid phone" style text for messages and reject files
+    static string describe(uint8_t errors);
+};
+
+#endif // VALIDATION_H
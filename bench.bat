@@ -0,0 +1,26 @@
+@echo off
+echo ================================================
+echo    HOSTEL ALLOTMENT SYSTEM - BENCHMARK SCRIPT
+echo ================================================
+echo.
+echo Usage: bench.bat [students]   (default 100000)
+echo.
+
+set STUDENTS=%1
+if "%STUDENTS%"=="" set STUDENTS=100000
+
+echo Compiling the benchmark...
+g++ -std=c++17 -Wall -Wextra -O2 -pthread -o hostel_benchmark.exe benchmark.cpp Student.cpp Room.cpp Admin.cpp HostelManager.cpp HostelIndex.cpp CsvUtils.cpp Journal.cpp CsvReader.cpp Snapshot.cpp AssignmentEngine.cpp RoomTable.cpp Keys.cpp Validation.cpp ReportEngine.cpp HostelStats.cpp BlockAllocator.cpp RoommateGrouper.cpp LoadArena.cpp SearchIndex.cpp HostelServer.cpp RoomReservations.cpp DataVersions.cpp AllocationTransaction.cpp ReshuffleEngine.cpp -lpsapi
+
+if errorlevel 1 (
+    echo.
+    echo COMPILATION FAILED! Please check the error messages above.
+    pause
+    exit /b 1
+)
+
+echo.
+hostel_benchmark.exe --students=%STUDENTS%
+echo.
+echo Machine-readable results: bench_results.jsonl
+pause
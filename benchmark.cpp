@@ -0,0 +1,781 @@
+/**
+ * @file benchmark.cpp
+ * @brief Benchmark Harness for Hostel Allotment System
+ *
+ * Generates a synthetic dataset (students.csv, rooms.csv, admins.csv) in
+ * a scratch directory and times the main phases against it:
+ * - load:              HostelManager startup from the CSVs
+ * - allocate_auto:     Admin::autoAllocateRooms
+ * - report:            one ReportEngine pass printed as all four reports
+ * - report_live:       allocation/occupancy/student reports from the live
+ *                      counters
+ * - save_csv:          saveStudents + saveRooms
+ * - save_snapshot:     binary snapshot write
+ * - load_snapshot:     HostelManager startup from the snapshot
+ * - search_build:      first student search, which builds the SearchIndex
+ * - search:            1000 searches (a name prefix and an email substring
+ *                      for each of 500 students spread over the data)
+ * - deallocate_all:    Admin::deallocateRoom for every allocated student
+ * - allocate_roommate: Admin::allocateWithRoommatePreference
+ * - allocate_block:    Admin::allocateByBlock with the benchmark seed
+ *                      (after another deallocation)
+ * - allocate_optimal:  Admin::allocateOptimal (after another deallocation)
+ * - reshuffle:         HostelManager::reshuffle of a file that rotates
+ *                      allocated students through three-room cycles (as
+ *                      moves) and pairwise swaps, up to 10000 students
+ * - serve_reads:       HostelServer on a Unix domain socket, one client
+ *                      thread and connection per core (at least 4), each
+ *                      sending 1000 student, room, rooms and search requests
+ * - serve_mixed:       the same with one request in ten replaced by a
+ *                      dealloc and allocate of one student back into its room
+ * - serve_allocate_race: the occupants of 64 rooms are released, then
+ *                      every client session races them for the beds of
+ *                      the first 32 through the server's allocate (bed
+ *                      claimed under the shared lock, committed under the
+ *                      exclusive one). A room over capacity, an
+ *                      acknowledged allocation without its bed, or a
+ *                      student/room link out of step fails the run
+ * - reserve_stress:    after another deallocation, 2 threads per core (at
+ *                      least 8) race for the beds of 64 rooms: lock-free
+ *                      HostelIndex::reserveBed, then Admin::commitAllocation
+ *                      under a mutex, with releases mixed in. A commit that
+ *                      fails for a reserved bed, a room over capacity or a
+ *                      student/room link out of step fails the run. Only
+ *                      the claim is lock-free: commits are serialised by
+ *                      design (the mutex here, the exclusive lock in the
+ *                      server), so this phase measures claim contention
+ * - journal_replay:    Journal::replay of 100000 allocate records followed
+ *                      by a record cut short by a crash. The torn record
+ *                      must be skipped, and after Journal::open a new
+ *                      record must replay on a line of its own, also when
+ *                      the torn record stopped inside a quoted field
+ * - unload:            HostelManager teardown
+ *
+ * Before unload the live counters are checked against a full
+ * recount; drift makes the benchmark exit with status 1, as does a failed
+ * serve_allocate_race, reserve_stress, reshuffle or journal_replay.
+ *
+ * Console output of the timed code goes to a null stream, so the numbers
+ * include formatting but not terminal I/O. Each phase prints one table row
+ * and appends one JSON object per line to the results file, e.g.
+ *   {"phase":"load","students":100000,"rooms":44000,"cores":4,
+ *    "seconds":0.21,"items_per_sec":666666,"peak_rss_kb":81234}
+ *
+ * Usage:
+ *   hostel_benchmark [--students=N] [--capacity-ratio=1.1]
+ *                    [--roommate-ratio=0.2] [--seed=42] [--arena=on|off]
+ *                    [--dir=bench_data] [--out=bench_results.jsonl]
+ *
+ * Loads use the normal thread policy (one parser thread per core for files
+ * over 1 MiB), so the core count is recorded with every result.
+ *
+ * @author Student Developer
+ * @version 1.0
+ * @date 2024
+ */
+
+#include "HostelManager.h"
+#include "HostelServer.h"
+#include "CsvUtils.h"
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <filesystem>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+// Peak resident set size of this process in KiB
+static size_t peakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / 1024;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss) / 1024; // bytes on macOS
+#else
+    return static_cast<size_t>(usage.ru_maxrss);        // KiB on Linux
+#endif
+#endif
+}
+
+// Discards everything written to it
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+struct BenchConfig {
+    size_t students = 10000;
+    double capacityRatio = 1.1;  // total bed capacity / student count
+    double roommateRatio = 0.2;  // share of students in a mutual roommate pair
+    unsigned seed = 42;
+    bool arena = true;           // load records into a LoadArena
+    string dir = "bench_data";
+    string out = "bench_results.jsonl";
+};
+
+// Benchmark reaches into HostelManager (declared a friend there) so each
+// phase can be timed on its own, without the batch commands' saves
+class Benchmark {
+private:
+    BenchConfig config;
+    size_t roomCount;
+    ofstream results;
+    NullBuffer nullBuffer;
+
+    string path(const string& name) const {
+        return (filesystem::path(config.dir) / name).string();
+    }
+
+    void generate();
+    void record(const string& phase, size_t items, double seconds);
+    double timed(const function<void()>& body);
+    bool serverPhases(HostelManager& manager, const vector<string>& queries);
+    bool reservationStress(HostelManager& manager);
+    bool journalReplay();
+
+public:
+    explicit Benchmark(const BenchConfig& config) : config(config), roomCount(0) {}
+    int run();
+};
+
+void Benchmark::generate() {
+    static const char* firstNames[] = {"Aarav", "Vihaan", "Vivaan", "Aditya", "Arjun", "Sai",
+                                       "Krishna", "Ishaan", "Rohan", "Kabir", "Ananya", "Diya",
+                                       "Aanya", "Pari", "Anika", "Navya", "Sara", "Myra",
+                                       "Ishika", "Trisha", "Kavya", "Kiara", "Riya", "Neha"};
+    static const char* lastNames[] = {"Patel", "Sharma", "Gupta", "Kumar", "Singh", "Reddy",
+                                      "Iyer", "Mehta", "Das", "Nair", "Verma", "Rao", "Menon",
+                                      "Khan", "Kapoor", "Jain", "Bhat", "Pillai", "Shah", "Joshi"};
+    static const char* courses[] = {"CSE", "ECE", "ME", "CE", "EE"};
+    static const char* types[] = {"Single", "Double", "Triple", "Quad"};
+    static const int baseRent[] = {5000, 7000, 8500, 9500};
+    const size_t roomsPerFloor = 20;
+    const size_t floorsPerBlock = 10;
+
+    filesystem::create_directories(config.dir);
+    mt19937_64 rng(config.seed);
+
+    // Rooms: Single/Double/Triple/Quad in rotation (2.5 beds on average)
+    size_t beds = static_cast<size_t>(config.students * config.capacityRatio);
+    roomCount = max<size_t>(1, (beds * 2 + 4) / 5);
+    {
+        ofstream rooms(path("rooms.csv"), ios::binary);
+        uniform_int_distribution<int> rentNoise(0, 10);
+        for (size_t i = 0; i < roomCount; ++i) {
+            size_t type = i % 4;
+            size_t floor = (i / roomsPerFloor) % floorsPerBlock + 1;
+            size_t block = i / (roomsPerFloor * floorsPerBlock);
+            string blockName(1, static_cast<char>('A' + block % 26));
+            if (block >= 26) blockName += to_string(block / 26);
+            rooms << (4001 + i) << ',' << types[type] << ',' << (type + 1) << ",0,"
+                  << (baseRent[type] + rentNoise(rng) * 50) << ',' << floor << ','
+                  << blockName << ",1,\n";
+        }
+    }
+
+    // Students: preferences lean towards low-numbered rooms (squared
+    // uniform), a share are mutual roommate pairs, about 1 in 200 names
+    // needs CSV quoting
+    {
+        ofstream students(path("students.csv"), ios::binary);
+        uniform_real_distribution<double> unit(0.0, 1.0);
+        uniform_int_distribution<int> preferenceCount(0, 5);
+        auto studentId = [](size_t i) {
+            ostringstream id;
+            id << "2024" << setw(9) << setfill('0') << (i + 1);
+            return id.str();
+        };
+        for (size_t i = 0; i < config.students; ++i) {
+            string first = firstNames[rng() % (sizeof(firstNames) / sizeof(*firstNames))];
+            string last = lastNames[rng() % (sizeof(lastNames) / sizeof(*lastNames))];
+            string name = (rng() % 200 == 0) ? last + ", " + first : first + " " + last;
+
+            // Pairs are (even, odd) neighbours so both sides agree
+            string roommate;
+            size_t pairBase = i & ~static_cast<size_t>(1);
+            if (pairBase + 1 < config.students &&
+                static_cast<double>(pairBase % 1000) / 1000.0 < config.roommateRatio) {
+                roommate = studentId(i ^ 1);
+            }
+
+            string preferences;
+            int count = preferenceCount(rng);
+            for (int p = 0; p < count; ++p) {
+                double u = unit(rng);
+                size_t room = static_cast<size_t>(u * u * roomCount);
+                if (!preferences.empty()) preferences += ';';
+                preferences += to_string(4001 + min(room, roomCount - 1));
+            }
+
+            string lower = first + last;
+            for (auto& c : lower) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+            students << studentId(i) << ',' << csvEscape(name) << ',' << lower << (i + 1)
+                     << "@example.com," << (9000000000ULL + i) << ','
+                     << courses[rng() % 5] << ',' << (rng() % 4 + 1) << ',' << roommate
+                     << ",,0," << preferences << '\n';
+        }
+    }
+
+    {
+        ofstream admins(path("admins.csv"), ios::binary);
+        admins << "ADM001,admin,admin123,System Administrator,admin@hostel.com\n";
+    }
+    filesystem::remove(path("hostel.journal"));
+    filesystem::remove(path("hostel.snap"));
+}
+
+double Benchmark::timed(const function<void()>& body) {
+    streambuf* console = cout.rdbuf(&nullBuffer);
+    auto start = chrono::steady_clock::now();
+    body();
+    auto stop = chrono::steady_clock::now();
+    cout.rdbuf(console);
+    return chrono::duration<double>(stop - start).count();
+}
+
+void Benchmark::record(const string& phase, size_t items, double seconds) {
+    double rate = (seconds > 0.0) ? items / seconds : 0.0;
+    size_t rss = peakRssKb();
+    cout << left << setw(20) << phase << right << setw(12) << fixed << setprecision(4) << seconds
+         << setw(16) << setprecision(0) << rate << setw(14) << rss << endl;
+    results << "{\"phase\":\"" << phase << "\",\"students\":" << config.students
+            << ",\"rooms\":" << roomCount << ",\"cores\":" << thread::hardware_concurrency()
+            << ",\"seed\":" << config.seed << ",\"arena\":" << (config.arena ? "true" : "false") << fixed << setprecision(6)
+            << ",\"seconds\":" << seconds << setprecision(0)
+            << ",\"items_per_sec\":" << rate << ",\"peak_rss_kb\":" << rss << "}\n";
+    results.flush();
+}
+
+int Benchmark::run() {
+    results.open(config.out, ios::app);
+    if (!results.is_open()) {
+        cerr << "Error: cannot open " << config.out << endl;
+        return 1;
+    }
+
+    HostelManager::setArenaLoading(config.arena);
+    auto start = chrono::steady_clock::now();
+    generate();
+    double generateSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Generated " << config.students << " students and " << roomCount << " rooms in "
+         << config.dir << " (" << fixed << setprecision(2) << generateSeconds << " s)" << endl;
+    cout << left << setw(20) << "Phase" << right << setw(12) << "Seconds" << setw(16) << "Items/s"
+         << setw(14) << "Peak RSS KiB" << endl;
+    cout << string(62, '-') << endl;
+
+    const size_t students = config.students;
+    const size_t everything = students + roomCount;
+    unique_ptr<HostelManager> manager;
+    auto open = [this, &manager]() {
+        manager.reset();
+        manager.reset(new HostelManager(path("students.csv"), path("rooms.csv"), path("admins.csv")));
+    };
+    record("load", everything, timed(open));
+    HostelManager& m = *manager;
+
+    record("allocate_auto", students, timed([&m]() {
+        m.batchAdmin().autoAllocateRooms(m.students, m.rooms, m.index);
+    }));
+    record("report", everything, timed([&m]() {
+        Admin& admin = m.batchAdmin();
+        ReportSummary summary = ReportEngine::compute(m.students, m.index.roomTable(), 0);
+        admin.generateAllocationReport(summary, cout);
+        admin.generateOccupancyReport(summary, cout);
+        admin.generateStudentReport(summary, cout);
+        admin.generateBreakdownReport(summary, cout);
+    }));
+    record("report_live", everything, timed([&m]() {
+        Admin& admin = m.batchAdmin();
+        ReportSummary summary = m.index.liveStats().summary(m.index.roomTable());
+        admin.generateAllocationReport(summary, cout);
+        admin.generateOccupancyReport(summary, cout);
+        admin.generateStudentReport(summary, cout);
+    }));
+    record("save_csv", everything, timed([&m]() {
+        m.saveStudents();
+        m.saveRooms();
+    }));
+    record("save_snapshot", everything, timed([&m]() { m.saveSnapshot(); }));
+    record("load_snapshot", everything, timed(open));
+
+    HostelManager& fresh = *manager;
+    record("search_build", students, timed([&fresh]() {
+        fresh.index.searchStudents(fresh.students, "a", SearchIndex::ALL_FIELDS, SearchIndex::PREFIX, 0, 20);
+    }));
+    vector<string> queries;
+    for (size_t i = 0; i < 500 && !fresh.students.empty(); ++i) {
+        const Student& student = fresh.students[i * fresh.students.size() / 500];
+        queries.emplace_back(student.getName().substr(0, 6));
+        queries.emplace_back(student.getEmail().substr(2, 6));
+    }
+    record("search", queries.size(), timed([&fresh, &queries]() {
+        for (size_t q = 0; q < queries.size(); ++q) {
+            fresh.index.searchStudents(fresh.students, queries[q], SearchIndex::ALL_FIELDS,
+                                       q % 2 ? SearchIndex::CONTAINS : SearchIndex::PREFIX, 0, 20);
+        }
+    }));
+
+    auto deallocateAll = [&fresh]() {
+        Admin& admin = fresh.batchAdmin();
+        for (size_t i = 0; i < fresh.students.size(); ++i) {
+            if (!fresh.students[i].getIsAllocated()) continue;
+            admin.deallocateRoom(fresh.students, fresh.rooms, fresh.index,
+                                 fresh.students[i].getKey(), cout);
+        }
+    };
+    record("deallocate_all", students, timed(deallocateAll));
+    record("allocate_roommate", students, timed([&fresh]() {
+        fresh.batchAdmin().allocateWithRoommatePreference(fresh.students, fresh.rooms, fresh.index);
+    }));
+    timed(deallocateAll);
+    record("allocate_block", students, timed([this, &fresh]() {
+        fresh.batchAdmin().allocateByBlock(fresh.students, fresh.rooms, fresh.index, config.seed);
+    }));
+    timed(deallocateAll);
+    record("allocate_optimal", students, timed([&fresh]() {
+        fresh.batchAdmin().allocateOptimal(fresh.students, fresh.rooms, fresh.index);
+    }));
+
+    // Rooms are mostly full now, so every change depends on the others
+    vector<size_t> allocated;
+    for (size_t i = 0; i < fresh.students.size(); ++i) {
+        if (fresh.students[i].getIsAllocated()) allocated.push_back(i);
+    }
+    shuffle(allocated.begin(), allocated.end(), mt19937(config.seed));
+    allocated.resize(min<size_t>(allocated.size(), 10000));
+    string reshufflePath = path("reshuffle.csv");
+    size_t reshuffleRows = 0;
+    {
+        ofstream out(reshufflePath);
+        size_t i = 0;
+        for (; i + 3 <= allocated.size() / 2; i += 3) {
+            const Student* cycle[3];
+            for (size_t k = 0; k < 3; ++k) cycle[k] = &fresh.students[allocated[i + k]];
+            for (size_t k = 0; k < 3; ++k) {
+                out << "move," << cycle[k]->getStudentId() << "," << cycle[(k + 1) % 3]->getAllocatedRoom() << "\n";
+            }
+            reshuffleRows += 3;
+        }
+        for (; i + 2 <= allocated.size(); i += 2) {
+            out << "swap," << fresh.students[allocated[i]].getStudentId() << ","
+                << fresh.students[allocated[i + 1]].getStudentId() << "\n";
+            reshuffleRows++;
+        }
+    }
+    bool reshuffled = false;
+    record("reshuffle", reshuffleRows, timed([&]() { reshuffled = fresh.reshuffle(reshufflePath); }));
+
+    bool raceHeld = serverPhases(fresh, queries);
+    timed(deallocateAll);
+    bool reservationsHeld = reservationStress(fresh);
+    bool journalRepaired = journalReplay();
+
+    bool consistent = fresh.checkStats() && reservationsHeld && raceHeld && reshuffled && journalRepaired;
+    record("unload", everything, timed([&manager]() { manager.reset(); }));
+    cout << "Results appended to " << config.out << endl;
+    return consistent ? 0 : 1;
+}
+
+bool Benchmark::serverPhases(HostelManager& manager, const vector<string>& queries) {
+    const string socketPath = path("hostel.sock");
+    const size_t clients = max<size_t>(4, thread::hardware_concurrency());
+    const size_t requestsPerClient = 1000;
+    const size_t studentCount = manager.students.size();
+    const size_t roomTotal = manager.rooms.size();
+    if (studentCount == 0 || roomTotal == 0 || queries.empty()) return true;
+
+    // Request scripts are written before the server starts; writers in
+    // serve_mixed each own distinct students, so every pair succeeds
+    auto script = [&](size_t client, bool writes) {
+        ostringstream requests;
+        requests << "login admin admin123\n";
+        size_t own = 0;
+        for (size_t r = 0; r < requestsPerClient; ++r) {
+            size_t pick = (client * requestsPerClient + r) * 7919;
+            if (writes && r % 10 == 9) {
+                size_t slot = (own++) * clients + client;
+                if (slot < studentCount && manager.students[slot].getIsAllocated()) {
+                    const Student& student = manager.students[slot];
+                    requests << "dealloc " << student.getStudentId() << "\n"
+                             << "allocate " << student.getStudentId() << ' '
+                             << student.getAllocatedRoom() << "\n";
+                    continue;
+                }
+            }
+            switch (r % 4) {
+            case 0: requests << "student " << manager.students[pick % studentCount].getStudentId() << "\n"; break;
+            case 1: requests << "room " << manager.rooms[pick % roomTotal].getRoomNumber() << "\n"; break;
+            case 2: requests << "rooms 1\n"; break;
+            default:
+                requests << "search " << (pick % 2 ? "--mode=contains " : "")
+                         << queries[pick % queries.size()] << "\n";
+            }
+        }
+        requests << "quit\n";
+        return requests.str();
+    };
+    auto runClients = [&](bool writes) {
+        vector<string> scripts;
+        for (size_t c = 0; c < clients; ++c) scripts.push_back(script(c, writes));
+        return timed([&]() {
+            vector<thread> threads;
+            for (size_t c = 0; c < clients; ++c) {
+                threads.emplace_back([&, c]() {
+                    istringstream requests(scripts[c]);
+                    ostream discard(&nullBuffer);
+                    HostelServer::runClient(socketPath, requests, discard);
+                });
+            }
+            for (auto& worker : threads) worker.join();
+        });
+    };
+    // Writers commit dealloc/allocate pairs of their own students, alone or
+    // while other sessions keep running full reports and exports from
+    // pinned versions; only the writers are timed
+    const size_t writers = max<size_t>(2, clients / 2);
+    size_t writeRequests = 0;
+    vector<string> writeScripts(writers);
+    for (size_t w = 0; w < writers; ++w) {
+        ostringstream requests;
+        requests << "login admin admin123\n";
+        for (size_t slot = w, pairs = 0; slot < studentCount && pairs < requestsPerClient / 2; slot += writers) {
+            const Student& student = manager.students[slot];
+            if (!student.getIsAllocated()) continue;
+            requests << "dealloc " << student.getStudentId() << "\n"
+                     << "allocate " << student.getStudentId() << ' ' << student.getAllocatedRoom() << "\n";
+            pairs++;
+            writeRequests += 2;
+        }
+        requests << "quit\n";
+        writeScripts[w] = requests.str();
+    }
+    auto runWriters = [&](bool withReports) {
+        atomic<bool> writing(true);
+        vector<thread> readers;
+        for (size_t r = 0; withReports && r < max<size_t>(2, clients - writers); ++r) {
+            readers.emplace_back([&, r]() {
+                while (writing) {
+                    istringstream requests(r % 2 ? "login admin admin123\nexport students\nquit\n"
+                                                 : "login admin admin123\nreport all\nquit\n");
+                    ostream discard(&nullBuffer);
+                    HostelServer::runClient(socketPath, requests, discard);
+                }
+            });
+        }
+        double seconds = timed([&]() {
+            vector<thread> threads;
+            for (size_t w = 0; w < writers; ++w) {
+                threads.emplace_back([&, w]() {
+                    istringstream requests(writeScripts[w]);
+                    ostream discard(&nullBuffer);
+                    HostelServer::runClient(socketPath, requests, discard);
+                });
+            }
+            for (auto& worker : threads) worker.join();
+        });
+        writing = false;
+        for (auto& reader : readers) reader.join();
+        return seconds;
+    };
+
+    // The occupants of twice as many rooms as are raced for are released
+    // (untimed), then every client session sends allocates for its share
+    // of them into the raced rooms at once. Each allocate claims its bed
+    // under the shared lock and commits under the exclusive one, so the
+    // claims really race; a room over capacity or a student/room link out
+    // of step afterwards fails the run
+    const size_t raceRooms = min<size_t>(32, roomTotal / 2);
+    vector<string> racedRooms;
+    vector<string> racers;
+    ostringstream releases;
+    releases << "login admin admin123\n";
+    for (size_t r = 0; r < 2 * raceRooms; ++r) {
+        const Room& room = manager.rooms[r];
+        if (r < raceRooms) racedRooms.push_back(room.getRoomNumber());
+        for (StudentKey occupant : room.getOccupantKeys()) {
+            racers.push_back(Keys::studentId(occupant));
+            releases << "dealloc " << racers.back() << "\n";
+        }
+    }
+    releases << "quit\n";
+    size_t raceRequests = 0;
+    vector<string> raceScripts(clients);
+    for (size_t c = 0; c < clients; ++c) {
+        ostringstream requests;
+        requests << "login admin admin123\n";
+        // Up to four rooms per student, spread so every room is contended
+        for (size_t i = c; i < racers.size(); i += clients) {
+            for (size_t k = 0; k < 4 && k < racedRooms.size(); ++k) {
+                requests << "allocate " << racers[i] << ' '
+                         << racedRooms[(i + k * 7) % racedRooms.size()] << "\n";
+                raceRequests++;
+            }
+        }
+        requests << "quit\n";
+        raceScripts[c] = requests.str();
+    }
+    atomic<size_t> raceAllocations(0);
+    auto runRace = [&]() {
+        istringstream requests(releases.str());
+        ostream discard(&nullBuffer);
+        HostelServer::runClient(socketPath, requests, discard);
+        return timed([&]() {
+            vector<thread> threads;
+            for (size_t c = 0; c < clients; ++c) {
+                threads.emplace_back([&, c]() {
+                    istringstream script(raceScripts[c]);
+                    ostringstream replies;
+                    HostelServer::runClient(socketPath, script, replies);
+                    const string reply = replies.str();
+                    const string allocated = "Room allocated successfully!";
+                    for (size_t at = reply.find(allocated); at != string::npos;
+                         at = reply.find(allocated, at + 1)) {
+                        raceAllocations++;
+                    }
+                });
+            }
+            for (auto& worker : threads) worker.join();
+        });
+    };
+
+    // Folding the journal into the files stalls every writer for a full
+    // save; keep it out of the request timings
+    size_t compactThreshold = manager.compactThreshold;
+    manager.compactThreshold = numeric_limits<size_t>::max();
+
+    // Start and stop inside timed() so the server's console lines go to
+    // the null stream; a reply to "help" means the accept loop is running
+    atomic<bool> failed(false);
+    bool serving = false;
+    thread server;
+    timed([&]() {
+        server = thread([&]() {
+            HostelServer hostelServer(manager);
+            if (!hostelServer.run(socketPath)) failed = true;
+        });
+        for (int attempt = 0; attempt < 2000 && !failed && !serving; ++attempt) {
+            istringstream probe("help\n");
+            ostream discard(&nullBuffer);
+            serving = HostelServer::runClient(socketPath, probe, discard);
+            if (!serving) this_thread::sleep_for(chrono::milliseconds(5));
+        }
+    });
+    if (serving) {
+        record("serve_reads", clients * requestsPerClient, runClients(false));
+        record("serve_mixed", clients * requestsPerClient, runClients(true));
+        record("serve_writes", writeRequests, runWriters(false));
+        record("serve_writes_reports", writeRequests, runWriters(true));
+        if (raceRooms > 0) record("serve_allocate_race", raceRequests, runRace());
+    } else {
+        cout << "Server phases skipped: could not serve on " << socketPath << endl;
+    }
+    timed([&]() {
+        if (serving) {
+            istringstream stop("login admin admin123\nshutdown\n");
+            ostream discard(&nullBuffer);
+            HostelServer::runClient(socketPath, stop, discard);
+        }
+        server.join();
+    });
+    manager.compactThreshold = compactThreshold;
+    if (!serving || raceRooms == 0) return true;
+
+    // The server is gone, so the records can be read without its lock
+    int racedBeds = 0, racedOccupants = 0;
+    size_t overfull = 0;
+    for (size_t r = 0; r < raceRooms; ++r) {
+        const Room& room = manager.rooms[r];
+        racedBeds += room.getCapacity();
+        racedOccupants += room.getCurrentOccupancy();
+        if (room.getCurrentOccupancy() > room.getCapacity()) overfull++;
+    }
+    vector<string> drift = manager.index.checkOccupancy(manager.students, manager.rooms, true);
+    if (overfull == 0 && drift.empty() && raceAllocations == static_cast<size_t>(racedOccupants)) return true;
+    cout << "Allocate race failed: " << overfull << " rooms over capacity, " << raceAllocations
+         << " allocations acknowledged for " << racedOccupants << " of " << racedBeds << " beds, "
+         << drift.size() << " occupancy problems" << endl;
+    for (size_t i = 0; i < drift.size() && i < 10; ++i) cout << "  " << drift[i] << endl;
+    return false;
+}
+
+bool Benchmark::reservationStress(HostelManager& manager) {
+    const size_t threads = max<size_t>(8, 2 * thread::hardware_concurrency());
+    const size_t opsPerThread = 20000;
+    const size_t hotRooms = min<size_t>(64, manager.rooms.size());
+    // Each thread holds at most 4 beds, so 5 students apiece always leave one free
+    if (hotRooms == 0 || manager.students.size() < 5 * threads) return true;
+
+    Admin& admin = manager.batchAdmin();
+    HostelIndex& index = manager.index;
+    mutex commitLock;
+    atomic<size_t> refusedCommits(0);
+    atomic<size_t> overCapacity(0);
+
+    // Each thread allocates only its own students (every threads-th slot),
+    // so a refused commit can only mean an over-reserved room
+    auto worker = [&](size_t t) {
+        mt19937 rng(static_cast<uint32_t>(config.seed + t));
+        vector<pair<size_t, size_t>> held; // student slot, room slot
+        size_t next = t;
+        ostream discard(&nullBuffer);
+        for (size_t op = 0; op < opsPerThread; ++op) {
+            bool release = !held.empty() && (held.size() >= 4 || rng() % 3 == 0);
+            if (release) {
+                size_t pick = rng() % held.size();
+                lock_guard<mutex> guard(commitLock);
+                admin.deallocateRoom(manager.students, manager.rooms, index,
+                                     manager.students[held[pick].first].getKey(), discard);
+                held[pick] = held.back();
+                held.pop_back();
+                continue;
+            }
+            while (next >= manager.students.size() || manager.students[next].getIsAllocated()) {
+                next = (next >= manager.students.size()) ? t : next + threads;
+            }
+            size_t room = rng() % hotRooms;
+            if (!index.reserveBed(room)) continue;
+            if (rng() % 4 == 0) this_thread::yield();
+            lock_guard<mutex> guard(commitLock);
+            const Room& target = manager.rooms[room];
+            if (admin.commitAllocation(manager.students, manager.rooms, index,
+                                       manager.students[next].getKey(), target.getKey(), discard)) {
+                held.emplace_back(next, room);
+                next += threads;
+            } else {
+                refusedCommits++;
+            }
+            if (target.getCurrentOccupancy() > target.getCapacity()) overCapacity++;
+        }
+    };
+
+    record("reserve_stress", threads * opsPerThread, timed([&]() {
+        vector<thread> workers;
+        for (size_t t = 0; t < threads; ++t) workers.emplace_back(worker, t);
+        for (auto& running : workers) running.join();
+    }));
+
+    vector<string> drift = index.checkOccupancy(manager.students, manager.rooms, true);
+    if (refusedCommits == 0 && overCapacity == 0 && drift.empty()) return true;
+    cout << "Reservation stress failed: " << refusedCommits << " refused commits, " << overCapacity
+         << " rooms over capacity, " << drift.size() << " occupancy problems" << endl;
+    for (size_t i = 0; i < drift.size() && i < 10; ++i) cout << "  " << drift[i] << endl;
+    return false;
+}
+
+bool Benchmark::journalReplay() {
+    const size_t records = 100000;
+    const string journalPath = path("replay.journal");
+    Journal journal;
+    if (!journal.open(journalPath) || !journal.truncate()) return false;
+    for (size_t i = 0; i < records; ++i) {
+        journal.logAllocate(to_string(2025000000000ULL + i), to_string(4001 + i % 1000));
+    }
+    journal.close();
+
+    vector<string> keys;
+    auto collect = [&keys](const string&, const string& key, const vector<string>&) { keys.push_back(key); };
+    // Appends a torn record, replays, then logs one more record after it
+    auto tearAndAppend = [&](const string& torn, const string& next) {
+        {
+            ofstream tail(journalPath, ios::app | ios::binary);
+            tail << torn;
+        }
+        keys.clear();
+        size_t replayed = journal.replay(journalPath, collect);
+        bool ok = journal.open(journalPath) && journal.logDeallocate(next);
+        journal.close();
+        return ok && replayed == keys.size();
+    };
+
+    bool ok = true;
+    record("journal_replay", records, timed([&]() {
+        ok = tearAndAppend("A,2025009999999,40", "2025000000001");
+    }));
+    ok = ok && keys.size() == records && tearAndAppend("S,\"2025009999998,Torn", "2025000000002");
+    keys.clear();
+    ok = ok && journal.replay(journalPath, collect) == records + 2 &&
+         keys[records] == "2025000000001" && keys[records + 1] == "2025000000002";
+    if (!ok) cout << "Journal replay failed: a torn record was replayed or swallowed the next one" << endl;
+    return ok;
+}
+
+/**
+ * @brief Parses --key=value options into the benchmark configuration
+ *
+ * @return bool False on an unknown option or malformed value
+ */
+static bool parseConfig(int argc, char* argv[], BenchConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eq = arg.find('=');
+        if (arg.compare(0, 2, "--") != 0 || eq == string::npos) {
+            cerr << "Unexpected argument: " << arg << endl;
+            return false;
+        }
+        string key = arg.substr(2, eq - 2);
+        string value = arg.substr(eq + 1);
+        try {
+            if (key == "students") config.students = stoul(value);
+            else if (key == "capacity-ratio") config.capacityRatio = stod(value);
+            else if (key == "roommate-ratio") config.roommateRatio = stod(value);
+            else if (key == "seed") config.seed = static_cast<unsigned>(stoul(value));
+            else if (key == "arena" && (value == "on" || value == "off")) config.arena = (value == "on");
+            else if (key == "dir") config.dir = value;
+            else if (key == "out") config.out = value;
+            else {
+                cerr << "Unknown option: --" << key << endl;
+                return false;
+            }
+        } catch (const exception&) {
+            cerr << "Invalid value for --" << key << ": " << value << endl;
+            return false;
+        }
+    }
+    if (config.students == 0 || config.capacityRatio <= 0.0 ||
+        config.roommateRatio < 0.0 || config.roommateRatio > 1.0) {
+        cerr << "Need --students > 0, --capacity-ratio > 0 and 0 <= --roommate-ratio <= 1" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    if (!parseConfig(argc, argv, config)) {
+        cerr << "Usage: hostel_benchmark [--students=N] [--capacity-ratio=1.1] "
+                "[--roommate-ratio=0.2] [--seed=42] [--arena=on|off] [--dir=bench_data] "
+                "[--out=bench_results.jsonl]" << endl;
+        return 2;
+    }
+    try {
+        Benchmark benchmark(config);
+        return benchmark.run();
+    } catch (const exception& e) {
+        cerr << "Benchmark failed: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -21,7 +21,7 @@ echo C++ compiler found. Starting compilation...
 echo.
 
 echo Compiling the application...
-g++ -std=c++11 -Wall -Wextra -O2 -o hostel_system.exe main.cpp Student.cpp Room.cpp Admin.cpp HostelManager.cpp
+g++ -std=c++17 -Wall -Wextra -O2 -pthread -o hostel_system.exe main.cpp Student.cpp Room.cpp Admin.cpp HostelManager.cpp HostelIndex.cpp CsvUtils.cpp Journal.cpp CsvReader.cpp Snapshot.cpp AssignmentEngine.cpp RoomTable.cpp Keys.cpp Validation.cpp ReportEngine.cpp HostelStats.cpp BlockAllocator.cpp RoommateGrouper.cpp LoadArena.cpp SearchIndex.cpp HostelServer.cpp RoomReservations.cpp DataVersions.cpp AllocationTransaction.cpp ReshuffleEngine.cpp
 
 if errorlevel 1 (
     echo.
@@ -1,35 +1,182 @@
 /**
  * @file main.cpp
  * @brief Hostel Allotment System - Main Application Entry Point
- * 
+ *
  * This is the main entry point for the Hostel Allotment System.
  * The system manages student room allocations with advanced features
  * including roommate preferences and automated allocation.
- * 
+ *
+ * Without arguments the interactive menus start. With a command the
+ * program runs headless: it loads the data, performs the command, saves
+ * once and exits.
+ *
+ *   hostel_system allocate --strategy=auto|roommate|optimal|block [--seed=N]
+ *   hostel_system import   --from=new_students.csv [--rejects=FILE]
+ *   hostel_system reshuffle --from=moves.csv  (move/swap rows, all or none)
+ *   hostel_system report   [--type=allocation|occupancy|student|breakdown|all]
+ *   hostel_system dealloc  --student=ID[,ID...] | --all
+ *   hostel_system check    (live counters vs. a full recount, room links)
+ *   hostel_system search   --query=TEXT [--field=any|name|email|course]
+ *                          [--mode=prefix|contains] [--page=N]
+ *   hostel_system serve    [--socket=hostel.sock]  (sessions share the data)
+ *   hostel_system client   [--socket=hostel.sock]  (requests from stdin)
+ *
+ * Every command also accepts --students=, --rooms= and --admins= to
+ * point at data files other than the defaults in the working directory.
+ *
  * @author Student Developer
  * @version 1.0
  * @date 2024
  */
 
 #include "HostelManager.h"
+#include "HostelServer.h"
 #include <iostream>
 #include <exception>
+#include <map>
+#include <sstream>
 
 using namespace std;
 
+/**
+ * @brief Prints command-line usage
+ */
+void printUsage() {
+    cout << "Usage:" << endl;
+    cout << "  hostel_system                                   interactive menus" << endl;
+    cout << "  hostel_system allocate --strategy=auto|roommate|optimal|block [--seed=N]" << endl;
+    cout << "  hostel_system import --from=FILE [--rejects=FILE]   (default FILE.rejects.csv)" << endl;
+    cout << "  hostel_system reshuffle --from=FILE             move,ID,ROOM and swap,ID,ID rows, all or none" << endl;
+    cout << "  hostel_system report [--type=allocation|occupancy|student|breakdown|all]" << endl;
+    cout << "  hostel_system dealloc --student=ID[,ID...] | --all" << endl;
+    cout << "  hostel_system check                             verify live statistics" << endl;
+    cout << "  hostel_system search --query=TEXT [--field=any|name|email|course] [--mode=prefix|contains] [--page=N]" << endl;
+    cout << "                                                  (exit 1 when nothing matches)" << endl;
+    cout << "  hostel_system serve [--socket=hostel.sock]      serve concurrent sessions" << endl;
+    cout << "  hostel_system client [--socket=hostel.sock]     send stdin lines to a server" << endl;
+    cout << "                                                  ('help' lists the commands)" << endl;
+    cout << "Data file options (any command):" << endl;
+    cout << "  --students=FILE --rooms=FILE --admins=FILE" << endl;
+}
+
+/**
+ * @brief Parses --key=value (or bare --flag) arguments after the command
+ *
+ * @return bool False if an argument is not in --key[=value] form
+ */
+bool parseOptions(int argc, char* argv[], map<string, string>& options) {
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.size() < 3 || arg.compare(0, 2, "--") != 0) {
+            cerr << "Unexpected argument: " << arg << endl;
+            return false;
+        }
+        size_t eq = arg.find('=');
+        if (eq == string::npos) options[arg.substr(2)] = "";
+        else options[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+    }
+    return true;
+}
+
+/**
+ * @brief Runs one headless command
+ *
+ * @return int Exit status (0 success, 1 command failed, 2 usage error)
+ */
+int runCommand(int argc, char* argv[]) {
+    string command = argv[1];
+    if (command == "help" || command == "--help" || command == "-h") {
+        printUsage();
+        return 0;
+    }
+
+    map<string, string> options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+    auto option = [&options](const string& key, const string& fallback) {
+        auto it = options.find(key);
+        return (it != options.end()) ? it->second : fallback;
+    };
+
+    if (command != "allocate" && command != "import" && command != "reshuffle" && command != "report" &&
+        command != "dealloc" && command != "check" && command != "search" && command != "serve" &&
+        command != "client") {
+        cerr << "Unknown command: " << command << endl;
+        printUsage();
+        return 2;
+    }
+    if ((command == "import" || command == "reshuffle") && option("from", "").empty()) {
+        cerr << command << " needs --from=FILE" << endl;
+        return 2;
+    }
+    if (command == "dealloc" && !options.count("all") && option("student", "").empty()) {
+        cerr << "dealloc needs --student=ID[,ID...] or --all" << endl;
+        return 2;
+    }
+    if (command == "search" && option("query", "").empty()) {
+        cerr << "search needs --query=TEXT" << endl;
+        return 2;
+    }
+
+    // The client needs no data of its own
+    if (command == "client") {
+        return HostelServer::runClient(option("socket", "hostel.sock"), cin, cout) ? 0 : 1;
+    }
+
+    HostelManager hostelSystem(option("students", "students.csv"),
+                               option("rooms", "rooms.csv"),
+                               option("admins", "admins.csv"));
+    bool ok = false;
+    if (command == "allocate") {
+        ok = hostelSystem.runAllocation(option("strategy", "auto"), option("seed", ""));
+    } else if (command == "import") {
+        string from = option("from", "");
+        ok = hostelSystem.importStudents(from, option("rejects", from + ".rejects.csv"));
+    } else if (command == "reshuffle") {
+        ok = hostelSystem.reshuffle(option("from", ""));
+    } else if (command == "report") {
+        ok = hostelSystem.printReports(option("type", "all"));
+    } else if (command == "check") {
+        ok = hostelSystem.checkStats();
+    } else if (command == "search") {
+        ok = hostelSystem.findStudents(option("query", ""), option("field", "any"),
+                                       option("mode", "prefix"), option("page", "1"));
+    } else if (command == "serve") {
+        ok = hostelSystem.serve(option("socket", "hostel.sock"));
+    } else if (options.count("all")) {
+        ok = hostelSystem.deallocateAll();
+    } else {
+        vector<string> ids;
+        stringstream list(option("student", ""));
+        string id;
+        while (getline(list, id, ',')) {
+            if (!id.empty()) ids.push_back(id);
+        }
+        ok = hostelSystem.deallocateStudents(ids);
+    }
+    return ok ? 0 : 1;
+}
+
 /**
  * @brief Main function - Application entry point
- * 
+ *
  * This function:
- * 1. Displays welcome message
- * 2. Creates HostelManager instance
- * 3. Runs the main application loop
- * 4. Handles exceptions gracefully
- * 
+ * 1. Runs a headless command when one is given on the command line
+ * 2. Otherwise displays welcome message
+ * 3. Creates HostelManager instance
+ * 4. Runs the main application loop
+ * 5. Handles exceptions gracefully
+ *
  * @return int Exit status (0 for success, 1 for error)
  */
-int main() {
+int main(int argc, char* argv[]) {
     try {
+        if (argc > 1) {
+            return runCommand(argc, argv);
+        }
+
         // Display welcome message
         cout << "================================================" << endl;
         cout << "    WELCOME TO HOSTEL ALLOTMENT SYSTEM" << endl;
@@ -38,11 +185,11 @@ int main() {
         cout << "allocations with roommate preferences and" << endl;
         cout << "automated assignment capabilities." << endl;
         cout << "================================================" << endl;
-        
+
         // Create and run the hostel management system
         HostelManager hostelSystem;
         hostelSystem.run();
-        
+
     } catch (const exception& e) {
         // Handle standard exceptions
         cerr << "Fatal Error: " << e.what() << endl;
@@ -53,8 +200,6 @@ int main() {
         cerr << "Unknown error occurred. The application will now exit." << endl;
         return 1;
     }
-    
+
     return 0;
 }
-
-